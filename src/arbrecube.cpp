@@ -18,148 +18,98 @@
  */
 
 
-#include "arbrecube.h"
-
+#include <cstdlib>
+#include <new>
 
-std::ostream& operator<<(std::ostream &Cout, const std::vector<long>& Path) {
-	for( std::vector<long>::const_iterator reve = Path.begin(); reve != Path.end(); ++reve)
-		Cout << static_cast<unsigned char>(*reve + 65);
-	return Cout;
-}
-
-
-Closure::Closure(const LatticePath& path, long NombreDimensions) :
-	PrunedDimensions( NombreDimensions, false)
-{
-	ClosedNodes.push_back(path);
-	Generators.push_back(path);
+#include "arbrecube.h"
 
-	// Also update the dimensions to prune
-	for(std::vector<long>::const_iterator it = path.begin(); it != path.end(); ++it)
-		PrunedDimensions[*it] = true;
-#ifdef DEBUG_CLOS
-	std::cout << "New closure with " << path << std::endl;
-#endif
-}
 
-void Closure::AddElement(const LatticePath& path)
+void Noeud::Fill_D_I( DotSet& TempD, CombinedSkyline& TempI, PointArena& Points)
 {
-#ifdef DEBUG_CLOS
-	std::cout << "\t\tAddElement: " << path << std::endl;
-#endif
+	size_t TailleTotale = TempD.size() + TempI.size();
+	for( CombinedSkyline::const_iterator iteSk = TempI.begin(); iteSk != TempI.end(); ++iteSk)
+		TailleTotale += iteSk->size();
 
-	std::vector<LatticePath>::const_iterator iteClos = ClosedNodes.begin();
-	for( ; iteClos != ClosedNodes.end(); ++iteClos)
-	{
-#ifdef DEBUG_CLOS
-		std::cout << "\t\t(*iteClos): " << *iteClos << std::endl;
-#endif
-		if( std::includes(	iteClos->begin(), iteClos->end(),
-							path.begin(), path.end()))
-			break;
-	}
+	PointId* Fin = Points.Allocate( TailleTotale);
+	Skyline = Fin;
+	NbD = TempD.size();
+	NbGroupes = TempI.size();
+	Taille = TailleTotale;
 
-	// The node belongs to the closure but isn't "closed" so it's a new closed node
-	if( iteClos == ClosedNodes.end())
+	Fin = std::copy( TempD.begin(), TempD.end(), Fin);
+	for( CombinedSkyline::const_iterator iteSk = TempI.begin(); iteSk != TempI.end(); ++iteSk)
 	{
-		ClosedNodes.push_back(path);
-
-		// Also update the dimensions to prune
-		for(std::vector<long>::const_iterator it = path.begin(); it != path.end(); ++it)
-			PrunedDimensions[*it] = true;
-#ifdef DEBUG_CLOS
-		std::cout << "Added as close" << std::endl;
-#endif
-		return;
+		*Fin++ = iteSk->size();
+		Fin = std::copy( iteSk->begin(), iteSk->end(), Fin);
 	}
 
-	// The node is "closed" so it could be a generator
-	std::vector<LatticePath>::iterator iteNoeuds = Generators.begin();
-	while( iteNoeuds != Generators.end())
-	{
-#ifdef DEBUG_CLOS
-		std::cout << "\t\tGen: " << *iteNoeuds << std::endl;
-#endif
-		// ok it isn't a generator, we just ignore it
-		if( iteNoeuds->size() < path.size() &&
-			std::includes( path.begin(), path.end(),
-							iteNoeuds->begin(), iteNoeuds->end() ) )
-		{
-#ifdef DEBUG_CLOS
-			std::cout << "\t\tIsn't gen" << std::endl;
-#endif
-			return;
-		}
-
-		if( iteNoeuds->size() > path.size() &&
-			std::includes( iteNoeuds->begin(), iteNoeuds->end(),
-							path.begin(), path.end() ) )
-		{
-#ifdef DEBUG_CLOS
-			std::cout << "\t\tErase " << *iteNoeuds << std::endl;
-#endif
-			iteNoeuds = Generators.erase(iteNoeuds);
-		}
-		else
-			++iteNoeuds;
-	}
-#ifdef DEBUG_CLOS
-	std::cout << "\t\tAdded as generator" << std::endl;
-#endif
-	Generators.push_back( path);
-}
-
-
-void Noeud::Fill_D_I( const DotSet& TempD, const CombinedSkyline& TempI)
-{
-	cs_D.reserve( TempD.size());
-	cs_D.assign( TempD.begin(), TempD.end());
-
-	cs_I.reserve( TempI.size());
-	CombinedSkyline::const_iterator iteSk;
-	for( iteSk = TempI.begin(); iteSk != TempI.end(); ++iteSk)
-	{
-		cs_I.push_back( CompactSet(0));
-		cs_I.back().reserve( (*iteSk).size());
-		cs_I.back().assign( (*iteSk).begin(), (*iteSk).end());
-	}
+	TempD.clear();
+	TempI.clear();
 }
 
 
-ArbreCube::ArbreCube( const double* matrice_p, const std::vector<bool>& FindLowest_p, long NombrePoints_p, long NombreDimensions_p) :
+template<typename T>
+ArbreCube<T>::ArbreCube( const T* matrice_p, const std::vector<bool>& FindLowest_p, long NombrePoints_p, long NombreDimensions_p) :
 	matrice( matrice_p),
 	NombrePoints( NombrePoints_p),
 	NombreDimensions( NombreDimensions_p),
 	FindLowest( FindLowest_p),
+	Lignes( 0),
+	VueDominance( matrice_p),
+	PasDimension( NombrePoints_p),
+	PasPoint( 1),
+	AllLowest( std::find( FindLowest_p.begin(), FindLowest_p.end(), false) == FindLowest_p.end()),
+	AlgoSkyline( SKY_BNL),
+	NbThreads( 1),
 	MyCnk( NombreDimensions_p),
-	racine( 0),
-	lastNode( 0),
+	FluxResultat( 0),
+	LabelsFlux( 0),
 	Compteur( 0),
 	Type1Count( 0),
 	NbSkylineFoundDirectly( 0),
-	NbSkylineFoundTotal( 0)
+	NbSkylineFoundTotal( 0),
+	Groupes( 0)
 {
-	MesNoeudClos.max_load_factor(0.75);
+}
 
-	for(std::vector<bool>::const_iterator it = FindLowest.begin(); it != FindLowest.end(); ++it) {
-		FindLowest1.push_back(*it ? 1 : 2);
-		FindLowest2.push_back(*it ? 2 : 1);
-	}
+template<typename T>
+ArbreCube<T>::~ArbreCube()
+{
+	free( Lignes);
+	for( size_t a = 0; a < SkylinesNoeuds.size(); a++)
+		delete SkylinesNoeuds[a];
 }
 
-ArbreCube::~ArbreCube()
+template<typename T>
+void ArbreCube<T>::UseRowMajor()
 {
-	delete racine;
-	for( HashClosure::const_iterator iteClos = MesNoeudClos.begin(); iteClos != MesNoeudClos.end(); ++iteClos)
-		delete iteClos->second;
-	//std::for_each( MesNoeudClos.begin(), MesNoeudClos.end(), DeleteObject());
-	if( lastNode)
-		delete lastNode;
+	if( Lignes != 0)
+		return;
+
+	// short rows are padded to a power of two so that none of them straddles two cache lines
+	const long TailleLigne = 64 / sizeof(T);
+	long Pas = NombreDimensions;
+	if( NombreDimensions <= TailleLigne)
+		for( Pas = 1; Pas < NombreDimensions; Pas *= 2);
+
+	void* Adresse;
+	if( posix_memalign( &Adresse, 64, std::max( NombrePoints * Pas, 1L) * sizeof(T)) != 0)
+		throw std::bad_alloc();
+	Lignes = static_cast<T*>(Adresse);
+
+	for( long i = 0; i < NombreDimensions; i++)
+		for( long j = 0; j < NombrePoints; j++)
+			Lignes[ j * Pas + i] = matrice[ i * NombrePoints + j];
+
+	VueDominance = Lignes;
+	PasDimension = 1;
+	PasPoint = Pas;
 }
 
-void ArbreCube::DepthAlgo( bool ComputeLast)
+template<typename T>
+void ArbreCube<T>::DepthAlgo( bool ComputeLast)
 {
-	if( racine != 0)			// the tree has already been generated
+	if( ! Niveaux.empty())			// the tree has already been generated
 		throw std::exception();
 
 	CurrentAlgo = DEPTH;
@@ -189,13 +139,12 @@ void ArbreCube::DepthAlgo( bool ComputeLast)
 	// Since the node of all dimensions is always a closure we compute and add it now
 	if( isLastNodeFirst)
 	{
-		lastNode = ComputeLastNode();
+		ComputeLastNode();
 		Compteur++;
 	}
 
-	std::vector<Noeud*>::const_iterator iteChildren;
-	for( iteChildren = racine->enfants.begin(); iteChildren != racine->enfants.end(); ++iteChildren)
-		GenereDimensionProf( **iteChildren, (*iteChildren)->depthD, (*iteChildren)->depthI);
+	for( long i = 0; i < NombreDimensions; i++)
+		GenereDimensionProf( NoeudProfondeur( DimensionBit( i), i, true), depthD[i], depthI[i]);
 
 #ifndef DEBUG
 	TempusFugit2 = Utils::GetTime();
@@ -206,9 +155,10 @@ void ArbreCube::DepthAlgo( bool ComputeLast)
 #endif // !DEBUG
 }
 
-void ArbreCube::BreadthAlgo( bool UseClosure)
+template<typename T>
+void ArbreCube<T>::BreadthAlgo( bool UseClosure)
 {
-	if( racine != 0)			// the tree has already been generated
+	if( ! Niveaux.empty())			// the tree has already been generated
 		throw std::exception();
 
 	CurrentAlgo = UseClosure ? BR_DOM : BREADTH;
@@ -227,17 +177,31 @@ void ArbreCube::BreadthAlgo( bool UseClosure)
 #endif // !DEBUG
 	std::cout << std::endl;
 
-	PileNm1.clear();
-	PileNm1.reserve( MyCnk.Value(1));
-
 #ifndef DEBUG
 	std::cout << "Generating N-Dimension spaces with N =";
 #endif // !DEBUG
 
 	GenereDimension1(false);
-	unsigned long NumDim = 2;
-	while( ! PileNm1.empty())
-		GenereDimensionN( NumDim++);
+	if( FluxResultat)
+		AfficheNiveau( 1, *FluxResultat, LabelsFlux);
+
+	for( long NumDim = 2; NumDim <= NombreDimensions; NumDim++)
+	{
+		GenereDimensionN( NumDim);
+
+		if( FluxResultat)
+		{
+			AfficheNiveau( NumDim, *FluxResultat, LabelsFlux);
+
+			// the parents of this level are not needed anymore, level 1 always is
+			if( NumDim > 2)
+			{
+				std::vector<Noeud>().swap( Niveaux[NumDim - 1]);
+				for( unsigned t = 0; t < NbThreads; t++)
+					ArenaNiveau( NumDim - 1, t).Clear();
+			}
+		}
+	}
 
 #ifndef DEBUG
 	TempusFugit2 = Utils::GetTime();
@@ -248,9 +212,10 @@ void ArbreCube::BreadthAlgo( bool UseClosure)
 #endif // !DEBUG
 }
 
-void ArbreCube::GenereBTrees()
+template<typename T>
+void ArbreCube<T>::GenereBTrees()
 {
-	stx::btree_multimap<double,long> TempBTree;
+	BTree TempBTree;
 
 	for( long i = 0; i < NombreDimensions; i++)
 	{
@@ -264,13 +229,26 @@ void ArbreCube::GenereBTrees()
 	}
 }
 
-void ArbreCube::GenereDimension1(bool depth)
+template<typename T>
+void ArbreCube<T>::GenereDimension1(bool depth)
 {
-	racine = new Noeud(NombreDimensions,0);
-	racine->parent = 0;
-	racine->offset = -1;
+	DotSet TempDotSet;
+	CombinedSkyline TempComb;
 
-	Noeud* TempNoeud;
+	// the single dimensions, the other levels are allocated as they are generated
+	Niveaux.resize( NombreDimensions + 1);
+	Niveaux[1].resize( NombreDimensions);
+
+	// level 1 is generated by a single thread, the others by NbThreads
+	SkylinesNoeuds.resize( 3 * NbThreads);
+	for( size_t a = 0; a < SkylinesNoeuds.size(); a++)
+		SkylinesNoeuds[a] = new PointArena;
+
+	if( depth)
+	{
+		depthD.resize( NombreDimensions);
+		depthI.resize( NombreDimensions);
+	}
 
 	if( CurrentAlgo == BREADTH || CurrentAlgo == BR_DOM)
 #ifndef DEBUG
@@ -281,17 +259,13 @@ void ArbreCube::GenereDimension1(bool depth)
 
 	for( long i = 0; i < NombreDimensions; i++)
 	{
-		DotSet TempDotSet;
-		CombinedSkyline TempComb;
-
-		TempNoeud = new Noeud(NombreDimensions-i-1,1);
-		TempNoeud->parent = racine;
+		Noeud* TempNoeud = &Niveaux[1][i];
+		TempNoeud->Chemin = DimensionBit(i);
 		TempNoeud->offset = i;
-		TempNoeud->Chemin.push_back( i);
 		TempNoeud->EstType1 = true;
-		racine->enfants.push_back( TempNoeud);
+		TempNoeud->EstComplet = false;
 
-		std::pair<stx::btree_multimap<double,long>::const_iterator,stx::btree_multimap<double,long>::const_iterator> Res;
+		std::pair<typename BTree::const_iterator,typename BTree::const_iterator> Res;
 
 		if( FindLowest[i])
 			Res = VecBtree[i].equal_range( VecBtree[i].begin().key());					// the first element holds the smallest value
@@ -311,61 +285,55 @@ void ArbreCube::GenereDimension1(bool depth)
 		}
 
 		if(depth) {
-			TempNoeud->depthD = TempDotSet;
-			TempNoeud->depthI = TempComb;
+			depthD[i].swap( TempDotSet);
+			depthI[i].swap( TempComb);
 		}
-		else
-			TempNoeud->Fill_D_I( TempDotSet, TempComb);
-		PileNm1.push_back( TempNoeud);
+		TempNoeud->Fill_D_I( TempDotSet, TempComb, ArenaNiveau( 1, 0));
 	}
 	Compteur = NombreDimensions;
 	Type1Count = NombreDimensions;
 }
 
-void ArbreCube::GenereDimensionProf(const Noeud& ParentNoeud, const DotSet& pcsD, const CombinedSkyline& pcsI, Closure* ParentGroup)
+template<typename T>
+void ArbreCube<T>::GenereDimensionProf(const NoeudProfondeur& ParentNoeud, const DotSet& pcsD, const CombinedSkyline& pcsI, Closure* ParentGroup)
 {
 #ifdef DEBUG
-		std::cout << "Noeud actuel : " << ParentNoeud.Chemin << std::endl;
+		std::cout << "Noeud actuel : " << Letters(ParentNoeud.Chemin) << std::endl;
 #endif
 
 	Closure* GroupFound = ParentGroup;
-	HashKey ParentKey(pcsD,pcsI);
+	SkylineRef ParentKey(pcsD,pcsI);
 	if(GroupFound == 0)
-		GroupFound = FindClosure(ParentKey, MesNoeudClos);
+		GroupFound = MesNoeudClos.Find(ParentKey);
 
 	// if we computed the last node first, we don't do anything if we reach it in the descent
-	if( ParentNoeud.Chemin.size() != static_cast<size_t>(NombreDimensions - 1) || !isLastNodeFirst)
+	if( SubspaceSize( ParentNoeud.Chemin) != NombreDimensions - 1 || !isLastNodeFirst)
 	{
 		for( long i = ParentNoeud.offset + 1; i < NombreDimensions; i++)
 		{
-			Noeud TempNoeud(NombreDimensions-i-1,ParentNoeud.Chemin.size()+1);
-			TempNoeud.offset = i;
-			TempNoeud.Chemin = ParentNoeud.Chemin;
-			TempNoeud.Chemin.push_back(i);
+			NoeudProfondeur TempNoeud( ParentNoeud.Chemin | DimensionBit(i), i, false);
 #ifdef DEBUG
-				std::cout << "Je suis: " << TempNoeud.Chemin << std::endl;
+				std::cout << "Je suis: " << Letters(TempNoeud.Chemin) << std::endl;
 #endif
 #ifdef DEBUG_CLOS
 			std::cout << ParentGroup << std::endl;
 #endif
-			if( GroupFound != 0 && GroupFound->PrunedDimensions[i]) {
+			if( GroupFound != 0 && (GroupFound->PrunedDimensions & DimensionBit(i))) {
 				TempNoeud.EstType1 = ParentNoeud.EstType1;
 				GenereDimensionProf(TempNoeud, pcsD, pcsI, GroupFound);
 			}
 			else {
-				Noeud* TempNewDim;
 				DotSet TempD;
 				CombinedSkyline TempI;
 
-				TempNewDim = racine->enfants[i];
-
 				// type 1 ?
 				if( ParentNoeud.EstType1)
-					ManageType1( &TempNoeud, TempD, TempI, pcsD, pcsI, TempNewDim->depthD, TempNewDim->depthI);
+					ManageType1( TempNoeud.EstType1, TempD, TempI, pcsD, pcsI, depthD[i], depthI[i]);
 
 				// type 2
 				if( TempNoeud.EstType1 == true)
 				{
+					Type1Count++;
 					NbSkylineFoundDirectly += TempD.size();
 					if( TempI.size() == 1)
 						NbSkylineFoundDirectly += TempI.begin()->size();
@@ -374,47 +342,25 @@ void ArbreCube::GenereDimensionProf(const Noeud& ParentNoeud, const DotSet& pcsD
 				{
 					// step 1
 					TempD.insert( pcsD.begin(), pcsD.end());
-					TempD.insert( TempNewDim->depthD.begin(), TempNewDim->depthD.end());
+					TempD.insert( depthD[i].begin(), depthD[i].end());
 					NbSkylineFoundDirectly += TempD.size();
 
-					DotSet bigDotSet;
-					const DotSet emptyDotSet;
-					std::list<DotSet> Result;
-					DotSet::const_iterator iteP = pcsD.begin();
-					DotSet::const_iterator iteN = TempNewDim->depthD.begin();
-					for( long i = 0; i < NombrePoints; i++)
+					std::vector<PointId> Candidats;
+					Candidats.reserve( NombrePoints - TempD.size());
+					DotSet::const_iterator iteD = TempD.begin();
+					for( long k = 0; k < NombrePoints; k++)
 					{
-						if( iteP != pcsD.end() && i == *iteP)
-						{
-							Result.push_back(emptyDotSet);
-							Result.back().insert(i);
-							++iteP;
-						}
+						if( iteD != TempD.end() && k == *iteD)
+							++iteD;
 						else
-						{
-							if( iteN != TempNewDim->depthD.end() && i == *iteN)
-							{
-								Result.push_back(emptyDotSet);
-								Result.back().insert(i);
-								++iteN;
-							}
-							else
-								bigDotSet.insert(i);
-						}
+							Candidats.push_back( k);
 					}
 
-					BNL( bigDotSet.begin(), bigDotSet.end(), TempNoeud.Chemin, Result);
-					for(std::list<DotSet>::const_iterator iteR = Result.begin(); iteR != Result.end(); ++iteR)
-					{
-						if( (*iteR).size() == 1)
-							TempD.insert(*(*iteR).begin());
-						else
-							TempI.insert(*iteR);
-					}
+					LatticePath Dimensions;
+					ExpandSubspace( TempNoeud.Chemin, Dimensions);
+					BNL( Candidats.begin(), Candidats.end(), Dimensions, TempD, TempI);
 				}
 
-				//TempNoeud->Fill_D_I( TempD, TempI);
-
 				NbSkylineFoundTotal += TempD.size();
 				for( CombinedSkyline::const_iterator itI = TempI.begin(); itI != TempI.end(); ++itI)
 					NbSkylineFoundTotal += (*itI).size();
@@ -431,7 +377,7 @@ void ArbreCube::GenereDimensionProf(const Noeud& ParentNoeud, const DotSet& pcsD
 		}
 	}
 #ifdef DEBUG
-	std::cout << "Je suis: " << ParentNoeud.Chemin << std::endl;
+	std::cout << "Je suis: " << Letters(ParentNoeud.Chemin) << std::endl;
 #endif
 
 	// we got a parent group meaning this node is in the same group than its parent
@@ -441,199 +387,206 @@ void ArbreCube::GenereDimensionProf(const Noeud& ParentNoeud, const DotSet& pcsD
 
 	// maybe this node belongs to a group from one of its legacy
 	if(!GroupFound)
-		GroupFound = FindClosure(ParentKey, MesNoeudClos);
+		GroupFound = MesNoeudClos.Find(ParentKey);
 
 	if(GroupFound)
 		GroupFound->AddElement(ParentNoeud.Chemin);
 	else
-		MesNoeudClos[ParentKey] = new Closure( ParentNoeud.Chemin, NombreDimensions);
+		MesNoeudClos.Insert( ParentKey, ParentNoeud.Chemin);
 }
 
-void ArbreCube::GenereDimensionN( unsigned long DimNumber)
+/*
+ * The children of the nodes of a level only read that level and level 1: every thread computes
+ * its share of them in place, in its own arena, and counts its type 1 nodes
+ */
+template<typename T>
+class ArbreCube<T>::GenerationNiveau : public ParallelTask
 {
-	std::vector<Noeud*>::iterator iteParents;
-	std::vector<Noeud*> TempPile;
-	TempPile.reserve( MyCnk.Value(DimNumber));
+public:
+	GenerationNiveau( ArbreCube<T>& Arbre_p, unsigned long DimNumber_p, unsigned NbParts) :
+		Arbre( Arbre_p),
+		DimNumber( DimNumber_p),
+		Brouillons( NbParts)
+	{
+	}
+
+	void Run( unsigned NumThread)
+	{
+		Arbre.GenereEnfants( DimNumber, NumThread, Brouillons.size(), Brouillons[NumThread]);
+	}
 
-	Noeud* TempNoeud;
-	Noeud* TempParent;
-	Noeud* TempNewDim;
+	unsigned long GetNbType1() const
+	{
+		unsigned long NbType1 = 0;
+		for( size_t t = 0; t < Brouillons.size(); t++)
+			NbType1 += Brouillons[t].NbType1;
+		return NbType1;
+	}
 
-	ParentsList ListeComposantes;
-	ParentsList::const_iterator iteComp;
+private:
+	ArbreCube<T>& Arbre;
+	const unsigned long DimNumber;
+	std::vector<BrouillonNiveau> Brouillons;
+};
 
-	UnDotSetList VecUDS;
+// consecutive nodes of a level generated by the same thread
+const size_t TAILLE_PAQUET = 16;
+
+template<typename T>
+void ArbreCube<T>::GenereDimensionN( unsigned long DimNumber)
+{
+	// the children of each node of the previous level follow each other, in the order of their parents
+	std::vector<Noeud>& Niveau = Niveaux[DimNumber];
+	Niveau.resize( MyCnk.Value(DimNumber));
 
 #ifndef DEBUG
-	std::cout << ' ' << (*(PileNm1.begin()))->offset + 2 << std::flush;
+	std::cout << ' ' << DimNumber << std::flush;
 #else
-	std::cout << "Generating N-Dimension spaces with N = " << (*(PileNm1.begin()))->offset + 2 << std::endl;
+	std::cout << "Generating N-Dimension spaces with N = " << DimNumber << std::endl;
 #endif // DEBUG
 
-	for( iteParents = PileNm1.begin(); iteParents != PileNm1.end(); ++iteParents)
+	// too few nodes to be worth sharing
+	unsigned NbParts = std::min<size_t>( NbThreads, std::max<size_t>( Niveau.size() / TAILLE_PAQUET, 1));
+
+	GenerationNiveau Tache( *this, DimNumber, NbParts);
+	Utils::RunParallel( Tache, NbParts);
+	Type1Count += Tache.GetNbType1();
+}
+
+template<typename T>
+void ArbreCube<T>::GenereEnfants( unsigned long DimNumber, unsigned NumThread, unsigned NbParts, BrouillonNiveau& Brouillon)
+{
+	const std::vector<Noeud>& Parents = Niveaux[DimNumber - 1];
+	std::vector<Noeud>& Niveau = Niveaux[DimNumber];
+	PointArena& Arena = ArenaNiveau( DimNumber, NumThread);
+
+	size_t Rang = 0;
+	for( typename std::vector<Noeud>::const_iterator iteParents = Parents.begin(); iteParents != Parents.end(); ++iteParents)
+		for( long i = iteParents->offset + 1; i < NombreDimensions; i++, Rang++)
+			if( (Rang / TAILLE_PAQUET) % NbParts == NumThread)
+				GenereNoeud( Niveau[Rang], *iteParents, i, Brouillon, Arena);
+}
+
+template<typename T>
+void ArbreCube<T>::GenereNoeud(	Noeud& TempNoeud,
+								const Noeud& TempParent,
+								long NewDim,
+								BrouillonNiveau& Brouillon,
+								PointArena& Arena)
+{
+	const Noeud& TempNewDim = Niveaux[1][NewDim];
+	DotSet& TempD = Brouillon.TempD;
+	CombinedSkyline& TempI = Brouillon.TempI;
+	LatticePath& Dimensions = Brouillon.Dimensions;
+	ParentsList& ListeComposantes = Brouillon.ListeComposantes;
+
+	TempNoeud.Chemin = TempParent.Chemin | DimensionBit(NewDim);
+	TempNoeud.offset = NewDim;
+
+	if( TempParent.EstComplet)
+		TempNoeud.EstComplet = true;
+	else
 	{
-		for( long i = (*iteParents)->offset + 1; i < NombreDimensions; i++)
-		{
-			TempNoeud = new Noeud(NombreDimensions-i-1,(*iteParents)->Chemin.size()+1);
-			TempNoeud->offset = i;
-			TempNoeud->parent = *iteParents;
-			(*iteParents)->enfants.push_back( TempNoeud);
-			TempNoeud->Chemin = (*iteParents)->Chemin;
-			TempNoeud->Chemin.push_back( i);
+		// type 1 ?
+		if( TempParent.EstType1)
+			ManageType1( TempNoeud.EstType1, TempD, TempI, TempParent.cs_D(), TempParent.cs_I(), TempNewDim.cs_D(), TempNewDim.cs_I());
 
-			TempParent = *iteParents;
-			TempNewDim = racine->enfants[i];
+		// type 2
+		if( TempNoeud.EstType1)
+			Brouillon.NbType1++;
+		else
+		{
+			ExpandSubspace( TempNoeud.Chemin, Dimensions);
+			ListeComposantes.clear();
+			CreateParentsList( Dimensions, ListeComposantes);
 
-			DotSet TempD;
-			CombinedSkyline TempI;
+			// step 1
+			for( ParentsList::const_iterator iteComp = ListeComposantes.begin(); iteComp != ListeComposantes.end(); ++iteComp)
+				TempD.insert( (*iteComp).Parent->cs_D().begin(), (*iteComp).Parent->cs_D().end());
 
-			if( TempNoeud->parent->EstComplet)
-				TempNoeud->EstComplet = true;
-			else
+			if( TempD.size() != static_cast<size_t>(NombrePoints))
 			{
-				// type 1 ?
-				if( TempNoeud->parent->EstType1)
-					ManageType1( TempNoeud, TempD, TempI, TempParent->cs_D, TempParent->cs_I, TempNewDim->cs_D, TempNewDim->cs_I);
+				// step 2
+				Breadth_Step_2_1( Brouillon.VecUDS, ListeComposantes, TempD);
+				Breadth_Step_2_2( Brouillon.VecUDS, TempD, TempI);
 
-				// type 2
-				if( TempNoeud->EstType1 == false)
+				if( TempD.size() != static_cast<size_t>(NombrePoints))
 				{
-					ListeComposantes.clear();
-					CreateParentsList( TempNoeud, ListeComposantes);
-
-					// step 1
-					for( iteComp = ListeComposantes.begin(); iteComp != ListeComposantes.end(); ++iteComp)
-						TempD.insert( (*iteComp).Parent->cs_D.begin(), (*iteComp).Parent->cs_D.end());
-
-					if( TempD.size() != static_cast<size_t>(NombrePoints))
+					// step 3
+					if( CurrentAlgo == BREADTH)
+						RangeBNL( Dimensions, TempD, TempI);
+					else
 					{
-						// step 2
-						Breadth_Step_2_1( VecUDS, ListeComposantes, TempNoeud, TempD);
-						Breadth_Step_2_2( VecUDS, TempD, TempI);
-
-						if( TempD.size() != static_cast<size_t>(NombrePoints))
-						{
-							// step 3
-							if( CurrentAlgo == BREADTH)
-								RangeBNL( TempNoeud, TempD, TempI);
-							else
-							{
-								assert( CurrentAlgo == BR_DOM);
-								TakeTheBus( TempD, TempI, TempNoeud);
-							}
-						}
+						assert( CurrentAlgo == BR_DOM);
+						TakeTheBus( TempD, TempI, Dimensions);
 					}
 				}
 			}
-
-			TempNoeud->Fill_D_I( TempD, TempI);
-
-			TempPile.push_back( TempNoeud);
 		}
 	}
 
-	TempPile.pop_back();	// remove the last element since it's always a leaf
-	PileNm1.swap( TempPile);
+	TempNoeud.Fill_D_I( TempD, TempI, Arena);
 }
 
-const Noeud* ArbreCube::ComputeLastNode()
+template<typename T>
+void ArbreCube<T>::ComputeLastNode()
 {
-	Noeud* TempNoeud = new Noeud(0,NombreDimensions);
-	TempNoeud->offset = NombreDimensions - 1;
-	TempNoeud->parent = 0;
-	for( long i = 0; i < NombreDimensions; i++)
-		TempNoeud->Chemin.push_back(i);
-
-	DotSet TempDotSet;
-	TempDotSet.insert(0);
-
-	TempCombined TempSkyline;
-	TempSkyline.push_back( TempDotSet);
+	const Subspace Chemin = FullSpace( NombreDimensions);
 
-	for( long j = 1; j < NombrePoints; j++)
-	{
-		bool KeepIt = true;
+	LatticePath Dimensions;
+	ExpandSubspace( Chemin, Dimensions);
 
-		for( TempCombined::iterator iteTempSk = TempSkyline.begin(); iteTempSk != TempSkyline.end(); )
-		{
-			PointOrderRelation ResultComp = ComparePoints( j, *((*iteTempSk).begin()), TempNoeud->Chemin);
-
-			if( ResultComp == P2_DOM_P1)
-			{
-				KeepIt = false;
-				break;
-			}
-			if( ResultComp == EQUIV)
-			{
-				KeepIt = false;
-				(*iteTempSk).insert( j);
-				break;
-			}
-			if( ResultComp == P1_DOM_P2)
-				TempSkyline.erase( iteTempSk++);
-			else
-				++iteTempSk;
-		}
-
-		if( KeepIt)
-		{
-			TempDotSet.clear();
-			TempDotSet.insert( j);
-			TempSkyline.push_back( TempDotSet);
-		}
-	}
-
-	TempDotSet.clear();
+	DotSet TempDotSet;
 	CombinedSkyline TempI;
 
-	TempCombined::iterator iteSk = TempSkyline.begin();
-	while( iteSk != TempSkyline.end())
-	{
-		if( (*iteSk).size() == 1)
-			TempDotSet.insert( *((*iteSk).begin()));
-		else
-			TempI.insert( *iteSk);
-		++iteSk;
-	}
-
-	//TempNoeud->Fill_D_I( TempDotSet, TempI);
-
-	MesNoeudClos[HashKey(TempDotSet, TempI)] = new Closure(TempNoeud->Chemin, NombreDimensions);
+	// the largest skyline of all, the partitioning pays off whatever the per-node choice
+	ParallelSkyline( VueDominance, PasDimension, PasPoint, FindLowest, Dimensions, NombrePoints, NbThreads, TempDotSet, TempI);
 
-	return TempNoeud;
+	MesNoeudClos.Insert( SkylineRef( TempDotSet, TempI), Chemin);
 }
 
-void ArbreCube::CreateParentsList( Noeud* TempNoeud, ParentsList& ListeComposantes)
+template<typename T>
+void ArbreCube<T>::CreateParentsList( const LatticePath& Chemin, ParentsList& ListeComposantes)
 {
-	const std::vector<long>& Chemin = TempNoeud->Chemin;
-
 #ifdef DEBUG
-	std::vector<long>::const_iterator itc;
+	LatticePath::const_iterator itc;
 	std::cout << "Chemin : ";
 	for( itc = Chemin.begin(); itc != Chemin.end(); ++itc)
 		std::cout << *itc << ",";
 	std::cout << std::endl;
 #endif // DEBUG
 
-	UnParent TempUnParent;
+	/*
+	 * A level lists its subspaces c_0 < ... < c_k-1 in lexicographic order, the rank of one of them
+	 * being Cnk(k) - 1 - sum over j of Binomial( NombreDimensions-1-c_j, k-j)
+	 * Removing c_p leaves the terms after p unchanged and lowers by one the k of those before p
+	 */
+	const unsigned long k = Chemin.size();
+	const std::vector<Noeud>& Parents = Niveaux[k - 1];
+	const unsigned long DernierRang = MyCnk.Value( k - 1) - 1;
 
-	// TODO change naive to smart processing (must be faster recursively)
-	for( size_t i = 0; i < Chemin.size(); i++)
+	unsigned long Apres = 0;
+	for( unsigned long j = 0; j < k; j++)
+		Apres += MyCnk.Binomial( NombreDimensions - 1 - Chemin[j], k - j);
+
+	UnParent TempUnParent;
+	unsigned long Avant = 0;
+	for( unsigned long p = 0; p < k; p++)
 	{
-		TempUnParent.Parent = racine;
-		for( size_t j = 0; j < Chemin.size(); j++)
-			if( i != j)
-				TempUnParent.Parent = TempUnParent.Parent->enfants[ Chemin[j] - TempUnParent.Parent->offset - 1];
-			else
-				TempUnParent.RemovedDim = Chemin[j];
+		const unsigned long Reste = NombreDimensions - 1 - Chemin[p];
+		Apres -= MyCnk.Binomial( Reste, k - p);
 
+		TempUnParent.Parent = &Parents[ DernierRang - Avant - Apres];
+		TempUnParent.RemovedDim = Chemin[p];
 		ListeComposantes.push_back( TempUnParent);
+
+		Avant += MyCnk.Binomial( Reste, k - 1 - p);
 	}
 }
 
-void ArbreCube::Breadth_Step_2_1(	UnDotSetList& VecUDS,
+template<typename T>
+void ArbreCube<T>::Breadth_Step_2_1(	UnDotSetList& VecUDS,
 									const ParentsList& ListeComposantes,
-									const Noeud* TempNoeud,
 									const DotSet& TempD)
 {
 	UnDotSet TempUDS;
@@ -641,11 +594,12 @@ void ArbreCube::Breadth_Step_2_1(	UnDotSetList& VecUDS,
 	VecUDS.clear();
 	for( ParentsList::const_iterator iteComp = ListeComposantes.begin(); iteComp != ListeComposantes.end(); ++iteComp)
 	{
-		for( CompactComb::const_iterator iteSkyline = (*iteComp).Parent->cs_I.begin(); iteSkyline != (*iteComp).Parent->cs_I.end(); ++iteSkyline)
+		const GroupList cs_I = (*iteComp).Parent->cs_I();
+		for( GroupList::const_iterator iteSkyline = cs_I.begin(); iteSkyline != cs_I.end(); ++iteSkyline)
 		{
 			if( AreDisjoint( TempD.begin(), TempD.end(), iteSkyline->begin(), iteSkyline->end()))
 			{
-				TempUDS.CombDotSet = &(*iteSkyline);
+				TempUDS.CombDotSet = *iteSkyline;
 				TempUDS.RemovedDim = (*iteComp).RemovedDim;
 				VecUDS.push_back( TempUDS);
 			}
@@ -653,20 +607,22 @@ void ArbreCube::Breadth_Step_2_1(	UnDotSetList& VecUDS,
 	}
 }
 
-void ArbreCube::Breadth_Step_2_2(	const UnDotSetList& VecUDS,
+template<typename T>
+void ArbreCube<T>::Breadth_Step_2_2(	const UnDotSetList& VecUDS,
 									DotSet& TempD,
 									CombinedSkyline& TempI)
 {
-	double TempMin;
-	double TempVal;
+	T TempMin;
+	T TempVal;
 	DotSet TempDotSet;
-	CompactSet::const_iterator iteDotSet;
+	PointRange::const_iterator iteDotSet;
 	CompactSet ListeMin;				// not a set, just using fast_lloc
+	CompactSet Seuls;
 	bool MustFindLowest;
 
 	for( UnDotSetList::const_iterator iteVecUDS = VecUDS.begin(); iteVecUDS != VecUDS.end(); ++iteVecUDS)
 	{
-		iteDotSet = (*iteVecUDS).CombDotSet->begin();
+		iteDotSet = (*iteVecUDS).CombDotSet.begin();
 		TempMin = matrice[ *iteDotSet + (*iteVecUDS).RemovedDim * NombrePoints];
 		ListeMin.clear();
 		ListeMin.push_back( *iteDotSet);
@@ -674,7 +630,7 @@ void ArbreCube::Breadth_Step_2_2(	const UnDotSetList& VecUDS,
 		MustFindLowest = FindLowest[(*iteVecUDS).RemovedDim];
 
 		// we look for the minimum value on the new dimension
-		while( iteDotSet != (*iteVecUDS).CombDotSet->end())
+		while( iteDotSet != (*iteVecUDS).CombDotSet.end())
 		{
 			TempVal = matrice[ *iteDotSet + (*iteVecUDS).RemovedDim * NombrePoints];
 			if( (MustFindLowest && TempVal < TempMin) || (!MustFindLowest && TempVal > TempMin))
@@ -692,7 +648,7 @@ void ArbreCube::Breadth_Step_2_2(	const UnDotSetList& VecUDS,
 		}
 
 		if( ListeMin.size() == 1)
-			TempD.insert( ListeMin[0]);
+			Seuls.push_back( ListeMin[0]);
 		else
 		{
 			TempDotSet.clear();
@@ -700,13 +656,16 @@ void ArbreCube::Breadth_Step_2_2(	const UnDotSetList& VecUDS,
 			TempI.insert( TempDotSet);
 		}
 	}
+
+	TempD.insert( Seuls.begin(), Seuls.end());
 }
 
-void ArbreCube::RangeBNL( const Noeud* TempNoeud, DotSet& TempD, CombinedSkyline& TempI)
+template<typename T>
+void ArbreCube<T>::RangeBNL( const LatticePath& Chemin, DotSet& TempD, CombinedSkyline& TempI)
 {
 	DotSet TempDotSet;
 
-	Step_3_1( TempDotSet, TempD, TempI, TempNoeud->Chemin);
+	Step_3_1( TempDotSet, TempD, TempI, Chemin);
 
 #ifdef DEBUG
 	std::cout << "\t\t\tEtape 3 : Points finaux: ";
@@ -718,38 +677,30 @@ void ArbreCube::RangeBNL( const Noeud* TempNoeud, DotSet& TempD, CombinedSkyline
 	if( TempDotSet.empty())
 		return;
 
-	std::list<DotSet> Stockage;
-	DotSet EmptyDotSet;
-
-	for( DotSet::const_iterator iteDs = TempD.begin(); iteDs != TempD.end(); ++iteDs)
-		Stockage.insert(Stockage.begin(), EmptyDotSet)->insert( *iteDs);
-	for( CombinedSkyline::const_iterator iteDs = TempI.begin(); iteDs != TempI.end(); ++iteDs)
-		Stockage.push_back( *iteDs);
-	BNL( TempDotSet.begin(), TempDotSet.end(), TempNoeud->Chemin, Stockage);
-
-	Step_3_3( Stockage, TempD, TempI);
+	BNL( TempDotSet.begin(), TempDotSet.end(), Chemin, TempD, TempI);
 }
 
 // TODO This method should never be used again with Depth algorithm, stand-by for conditionals cleanup
-void ArbreCube::Step_3_1(	DotSet& TempDotSet,
+template<typename T>
+void ArbreCube<T>::Step_3_1(	DotSet& TempDotSet,
 							const DotSet& TempD,
 							const CombinedSkyline& TempI,
-							const std::vector<long>& Path)
+							const LatticePath& Path)
 {
 	DotSet::const_iterator iteDotSet;
 	CombinedSkyline::const_iterator iteSkyline;
-	double TempMin;
-	double TempMax;
-	double TempVal;
-	stx::btree_multimap<double,long>::const_iterator iteLowerBound;
-	stx::btree_multimap<double,long>::const_iterator iteUpperBound;
+	T TempMin;
+	T TempMax;
+	T TempVal;
+	typename BTree::const_iterator iteLowerBound;
+	typename BTree::const_iterator iteUpperBound;
 	DotSet InterDotSet;
 
 #ifdef DEBUG
-	stx::btree_multimap<double,long>::const_iterator iteLowerBoundDebug;
+	typename BTree::const_iterator iteLowerBoundDebug;
 #endif // DEBUG
 
-	for( std::vector<long>::const_iterator iteChemin = Path.begin(); iteChemin != Path.end(); ++iteChemin)
+	for( LatticePath::const_iterator iteChemin = Path.begin(); iteChemin != Path.end(); ++iteChemin)
 	{
 		long Dimension_Number = *iteChemin;
 		iteDotSet = TempD.begin();
@@ -800,8 +751,7 @@ void ArbreCube::Step_3_1(	DotSet& TempDotSet,
 		if( iteChemin == Path.begin())
 		{
 			TempDotSet.clear();
-			for( ; iteLowerBound != iteUpperBound; ++iteLowerBound)
-				TempDotSet.insert( iteLowerBound.data());
+			Union( TempDotSet, iteLowerBound, iteUpperBound);
 #ifdef DEBUG
 			std::cout << "\t\t\tEtape 3 : Intersection : ";
 			for( DotSet::const_iterator iteDD = TempDotSet.begin(); iteDD != TempDotSet.end(); ++iteDD)
@@ -840,49 +790,10 @@ void ArbreCube::Step_3_1(	DotSet& TempDotSet,
 }
 
 
-void ArbreCube::Step_3_3( const std::list<DotSet>& Stockage, DotSet& TempD, CombinedSkyline& TempI)
-{
-	assert( ! Stockage.empty());
-
-	TempD.clear();
-	TempI.clear();
-
-	for( std::list<DotSet>::const_iterator iteCSL = Stockage.begin(); iteCSL != Stockage.end(); ++iteCSL)
-	{
-		if( (*iteCSL).size() == 1)
-			TempD.insert( *((*iteCSL).begin()));
-		else
-			TempI.insert( *iteCSL);
-	}
-}
-
-PointOrderRelation CPtab[4] = { EQUIV , P1_DOM_P2 , P2_DOM_P1 , UNCOMP };
-
-PointOrderRelation ArbreCube::ComparePoints( long P1, long P2, const std::vector<long>& Chemin)
-{
-	double v1;
-	double v2;
-	uint8_t Status = 0;
-	std::vector<long>::const_iterator iteChemin;
-
-	for( iteChemin = Chemin.begin(); Status != 3 && iteChemin != Chemin.end(); ++iteChemin)
-	{
-		v1 = matrice[ *iteChemin * NombrePoints + P1 ];
-		v2 = matrice[ *iteChemin * NombrePoints + P2 ];
-
-		if( v1 < v2)
-			Status |= FindLowest1[*iteChemin];
-		else
-			if( v1 > v2)
-				Status |= FindLowest2[*iteChemin];
-	}
-
-	return CPtab[Status];
-}
-
-void ArbreCube::Intersection(	DotSet& sk,
-								stx::btree_multimap<double,long>::const_iterator& iteLowerBound,
-								stx::btree_multimap<double,long>::const_iterator& iteUpperBound)
+template<typename T>
+void ArbreCube<T>::Intersection(	DotSet& sk,
+								typename BTree::const_iterator& iteLowerBound,
+								typename BTree::const_iterator& iteUpperBound)
 {
 
 #ifdef DEBUG
@@ -896,7 +807,7 @@ void ArbreCube::Intersection(	DotSet& sk,
 		return;
 	}
 
-	std::vector<long> VecPoints;
+	std::vector<PointId> VecPoints;
 
 	while( iteLowerBound != iteUpperBound)
 	{
@@ -905,81 +816,52 @@ void ArbreCube::Intersection(	DotSet& sk,
 	}
 	std::sort( VecPoints.begin(), VecPoints.end());
 
-	DotSet::const_iterator iteSK = sk.begin();
-	std::vector<long>::const_iterator iteVP = VecPoints.begin();
-
-	if( *iteSK < *iteVP)
-		iteSK = sk.lower_bound( *iteVP);
-	sk.erase( sk.begin(), iteSK);
-
-	while( iteSK != sk.end() && iteVP != VecPoints.end())
-	{
-		if( *iteSK < *iteVP)
-			sk.erase(iteSK++);
-		else
-		{
-			if( *iteSK == *iteVP)
-				++iteSK;
-			++iteVP;;
-		}
-	}
-
-	if( iteSK != sk.end())
-		sk.erase( iteSK, sk.end());
+	sk.Intersect( VecPoints.begin(), VecPoints.end());
 }
 
 
-void ArbreCube::Union(	DotSet& sk,
-						stx::btree_multimap<double,long>::const_iterator& iteLowerBound,
-						stx::btree_multimap<double,long>::const_iterator& iteUpperBound)
+template<typename T>
+void ArbreCube<T>::Union(	DotSet& sk,
+						typename BTree::const_iterator& iteLowerBound,
+						typename BTree::const_iterator& iteUpperBound)
 {
 	if( iteLowerBound == iteUpperBound)
 		return;
 
+	std::vector<PointId> VecPoints;
 	for( ; iteLowerBound != iteUpperBound; ++iteLowerBound)
-		sk.insert( iteLowerBound->second);
+		VecPoints.push_back( iteLowerBound->second);
+	sk.insert( VecPoints.begin(), VecPoints.end());
 }
 
 
-void ArbreCube::RemoveIncluded( DotSet& InterDotSet,
+template<typename T>
+void ArbreCube<T>::RemoveIncluded( DotSet& InterDotSet,
 								const DotSet& TempD,
 								const CombinedSkyline& TempI)
 {
-	DotSet::iterator iteIDS = InterDotSet.begin();
-	DotSet::const_iterator iteTN = TempD.begin();
+	InterDotSet.Remove( TempD.begin(), TempD.end());
 
-	while( iteIDS != InterDotSet.end() && iteTN != TempD.end())
-	{
-		if( *iteIDS < *iteTN)
-			++iteIDS;
-		else
-		{
-			if( *iteIDS == *iteTN)
-				InterDotSet.erase( iteIDS++);
-			++iteTN;
-		}
-	}
+	if( TempI.empty())
+		return;
 
+	// the groups are disjoint, a single pass over all their points is enough
+	std::vector<PointId> Combines;
 	for( CombinedSkyline::const_iterator iteSk = TempI.begin(); iteSk != TempI.end(); ++iteSk)
-	{
-		for( iteIDS = InterDotSet.begin(); iteIDS != InterDotSet.end();)
-		{
-			if( (*iteSk).count( *iteIDS) == 1)
-				InterDotSet.erase( iteIDS++);
-			else
-				++iteIDS;
-		}
-	}
+		Combines.insert( Combines.end(), (*iteSk).begin(), (*iteSk).end());
+	std::sort( Combines.begin(), Combines.end());
+	InterDotSet.Remove( Combines.begin(), Combines.end());
 }
 
 
-void ArbreCube::TakeTheBus( DotSet& TempD, CombinedSkyline& TempI, const Noeud* TempNoeud)
+template<typename T>
+void ArbreCube<T>::TakeTheBus( DotSet& TempD, CombinedSkyline& TempI, const LatticePath& Chemin)
 {
 	// Get the maximal domain value
-	long dim = TempNoeud->Chemin[0];
+	long dim = Chemin[0];
 	double value = domainSize[dim];
-	std::vector<long>::const_iterator iteChemin;
-	for( iteChemin = TempNoeud->Chemin.begin()+1; iteChemin != TempNoeud->Chemin.end(); ++iteChemin)
+	LatticePath::const_iterator iteChemin;
+	for( iteChemin = Chemin.begin()+1; iteChemin != Chemin.end(); ++iteChemin)
 	{
 		double vtmp = domainSize[*iteChemin];
 		if( vtmp >= value)
@@ -990,37 +872,27 @@ void ArbreCube::TakeTheBus( DotSet& TempD, CombinedSkyline& TempI, const Noeud*
 	}
 
 	// Prepare our list of Skylines already found in the previous steps
-	std::multimap<double,long> SP;
+	std::multimap<double,PointId> SP;
 	DotSet Omega;
 	Flatten( TempD.begin(), TempD.end(), TempI.begin(), TempI.end(), Omega);
 
 	for( DotSet::const_iterator iteDs = Omega.begin(); iteDs != Omega.end(); ++iteDs)
-		SP.insert( std::pair<double,long>(Sum(*iteDs,TempNoeud->Chemin), *iteDs));
+		SP.insert( std::pair<double,PointId>(Sum(*iteDs,Chemin), *iteDs));
+
+	const BTree& TempBTree = VecBtree[dim];
+	PathComparator<T> ComparePoints( VueDominance, PasDimension, PasPoint, FindLowest, Chemin);
 
-	const stx::btree_multimap<double,long>& TempBTree = VecBtree[dim];
 	long count = 0;
 
+	// the elements already known to be skyline aren't evaluated again
 	if( FindLowest[dim])
-	{
-		for( stx::btree_multimap<double,long>::const_iterator itPoints = TempBTree.begin(); itPoints != TempBTree.end(); ++itPoints)
-		{
-			// If the element isn't skyline, evaluate it
-			if( Omega.find(itPoints.data()) == Omega.end())
-				count += Evaluate( itPoints.data(), SP, TempNoeud->Chemin, TempD, TempI);
-		}
-	}
+		count += EvaluateAll( TempBTree.begin(), TempBTree.end(), Omega, SP, Chemin, ComparePoints, TempD, TempI);
 	else
-	{
-		for( stx::btree_multimap<double,long>::const_reverse_iterator itPoints = TempBTree.rbegin(); itPoints != TempBTree.rend(); ++itPoints)
-		{
-			if( Omega.find(itPoints.data()) == Omega.end())
-				count += Evaluate( itPoints.data(), SP, TempNoeud->Chemin, TempD, TempI);
-		}
-	}
+		count += EvaluateAll( TempBTree.rbegin(), TempBTree.rend(), Omega, SP, Chemin, ComparePoints, TempD, TempI);
 
 #ifdef DEBUG
 	/*std::cout << "Final Elements in SP: " << std::endl;
-	for (std::multimap<double, long>::iterator it = SP.begin();it != SP.end();++it)
+	for (std::multimap<double,PointId>::iterator it = SP.begin();it != SP.end();++it)
 		std::cout << "  [" << (*it).first << ", P" << (*it).second+1 << "]" << std::endl;*/
 	std::cout << "Number of comparisons: " << count << std::endl;
 	//std::cout << "Final Result for the current node: " << std::endl;
@@ -1030,9 +902,11 @@ void ArbreCube::TakeTheBus( DotSet& TempD, CombinedSkyline& TempI, const Noeud*
 }
 
 
-long ArbreCube::Evaluate(	long NumPoint,
-							std::multimap<double,long> &SP,
-							const std::vector<long>& Chemin,
+template<typename T>
+long ArbreCube<T>::Evaluate(	PointId NumPoint,
+							std::multimap<double,PointId> &SP,
+							const LatticePath& Chemin,
+							const PathComparator<T>& ComparePoints,
 							DotSet& TempD,
 							CombinedSkyline& TempI )
 {
@@ -1043,11 +917,11 @@ long ArbreCube::Evaluate(	long NumPoint,
 //#endif //DEBUG
 
 	long count = 0;
-	for (std::multimap<double, long>::const_iterator it = SP.begin();it != SP.end();++it)
+	for (std::multimap<double,PointId>::const_iterator it = SP.begin();it != SP.end();++it)
 	{
 		if(Fq < (*it).first) // Direct insertion as a Skyline
 		{
-			SP.insert(std::pair<double, long>(Fq,NumPoint));
+			SP.insert(std::pair<double,PointId>(Fq,NumPoint));
 			// Insert directly in the distinct skyline points
 			TempD.insert(NumPoint);
 			return 0;
@@ -1055,7 +929,7 @@ long ArbreCube::Evaluate(	long NumPoint,
 		else
 		{
 			count++;
-			PointOrderRelation ResultComp = ComparePoints((*it).second,NumPoint, Chemin);
+			PointOrderRelation ResultComp = ComparePoints((*it).second,NumPoint);
 			// Domination test p < q or p EQUIV q
 			if( ResultComp == P1_DOM_P2)
 			{
@@ -1078,7 +952,7 @@ long ArbreCube::Evaluate(	long NumPoint,
 						ds.insert(NumPoint);
 						TempI.erase(iteDs);
 						TempI.insert(ds);
-						SP.insert(std::pair<double, long>(Fq,NumPoint));
+						SP.insert(std::pair<double,PointId>(Fq,NumPoint));
 						return count;
 					}
 				}
@@ -1092,7 +966,7 @@ long ArbreCube::Evaluate(	long NumPoint,
 				TempI.insert(ds1);
 				// Enlever P du indistinct set
 				TempD.erase((*it).second);
-				SP.insert(std::pair<double, long>(Fq,NumPoint));
+				SP.insert(std::pair<double,PointId>(Fq,NumPoint));
 				return count;
 			}
 
@@ -1105,29 +979,39 @@ long ArbreCube::Evaluate(	long NumPoint,
 //	std::cout << "Number of comparison tests " << count << std::endl;
 //#endif //DEBUG
 
-	SP.insert(std::pair<double, long>(Fq,NumPoint));
+	SP.insert(std::pair<double,PointId>(Fq,NumPoint));
 	TempD.insert(NumPoint);
 	return count;
 }
 
 
-double ArbreCube::Sum( long NumPoint, const std::vector<long>& Chemin)
+template<typename T>
+double ArbreCube<T>::Sum( PointId NumPoint, const LatticePath& Chemin)
 {
 	double Total = 0;
+	const T* Point = VueDominance + NumPoint * PasPoint;
+
+	if( AllLowest)
+	{
+		for( size_t i = 0; i < Chemin.size(); i++)
+			Total += Point[ Chemin[i] * PasDimension];
+		return Total;
+	}
 
 	for( size_t i = 0; i < Chemin.size(); i++)
 	{
 		if( FindLowest[Chemin[i]])
-			Total += matrice[ Chemin[i] * NombrePoints + NumPoint];
+			Total += Point[ Chemin[i] * PasDimension];
 		else
-			Total -= matrice[ Chemin[i] * NombrePoints + NumPoint];
+			Total -= Point[ Chemin[i] * PasDimension];
 	}
 
 	return Total;
 }
 
 
-double ArbreCube::getDomaineSize(int dimension)
+template<typename T>
+double ArbreCube<T>::getDomaineSize(int dimension)
 {
 	double minValue = VecBtree[dimension].begin().key();
 	double maxValue = VecBtree[dimension].rbegin().key();
@@ -1136,70 +1020,49 @@ double ArbreCube::getDomaineSize(int dimension)
 }
 
 
-Closure* ArbreCube::FindClosure( const HashKey& keyToFind, const HashClosure& VecNoeuds)
+template<typename T>
+void ArbreCube<T>::AfficheResultat( std::ostream& Cout, const LabelArena* Labels) const
 {
-	if( VecNoeuds.empty())
-		return 0;
-
-	HashClosure::const_iterator iteClos = VecNoeuds.find(keyToFind);
-	if( iteClos != VecNoeuds.end())
-		return iteClos->second;
-
-	return 0;
+	// each level lists the children of the nodes of the previous one in order: breadth-first
+	for( size_t NumDim = 1; NumDim < Niveaux.size(); NumDim++)
+		AfficheNiveau( NumDim, Cout, Labels);
 }
 
 
-void ArbreCube::AfficheResultat( std::ostream& Cout, std::vector<std::string>* Labels) const
+template<typename T>
+void ArbreCube<T>::AfficheNiveau( size_t NumDim, std::ostream& Cout, const LabelArena* Labels) const
 {
-	std::vector<Noeud*> Pile;
-	for( size_t i = 0; i < racine->enfants.size(); i++)
-		AfficheNoeud( racine->enfants[i], Pile, Cout, Labels);
-
-	while( ! Pile.empty())
-		AfficheLargeur( Pile, Cout, Labels);
+	for( typename std::vector<Noeud>::const_iterator iteNoeud = Niveaux[NumDim].begin(); iteNoeud != Niveaux[NumDim].end(); ++iteNoeud)
+		AfficheNoeud( *iteNoeud, Cout, Labels);
 }
 
 
-void ArbreCube::AfficheLargeur( std::vector<Noeud*>& Pile,
+template<typename T>
+void ArbreCube<T>::AfficheNoeud(	const Noeud& TempNoeud,
 								std::ostream& Cout,
-								std::vector<std::string>* Labels) const
+								const LabelArena* Labels) const
 {
-	std::vector<Noeud*> TempPile;
-
-	for( size_t i = 0; i < Pile.size(); i++)
-		AfficheNoeud( Pile[i], TempPile, Cout, Labels);
-
-	Pile.swap(TempPile);
-}
-
-
-void ArbreCube::AfficheNoeud(	const Noeud *TempNoeud,
-								std::vector<Noeud*>& Pile,
-								std::ostream& Cout,
-								std::vector<std::string>* Labels) const
-{
-	if( TempNoeud == 0)
-		return;
-
-	PrintPath( TempNoeud->Chemin, Cout);
+	PrintPath( TempNoeud.Chemin, Cout);
 
 	Cout << " : ";
-	AfficheSkyline( TempNoeud->cs_D, TempNoeud->cs_I, TempNoeud->EstComplet, Cout, Labels);
+	AfficheSkyline( TempNoeud.cs_D(), TempNoeud.cs_I(), TempNoeud.EstComplet, Cout, Labels);
 	Cout << std::endl;
-
-	for( size_t i = 0; i < TempNoeud->enfants.size(); i++)
-		Pile.push_back( TempNoeud->enfants[i]);
 }
 
 
-void ArbreCube::AfficheClos( std::ostream& Cout, std::vector<std::string>* Labels) const
+template<typename T>
+void ArbreCube<T>::AfficheClos( std::ostream& Cout, const LabelArena* Labels) const
 {
-	for( HashClosure::const_iterator iteClos = MesNoeudClos.begin(); iteClos != MesNoeudClos.end(); ++iteClos)
+	CompactSet D;
+	CompactComb I;
+	for( size_t NumClos = 0; NumClos < MesNoeudClos.Size(); NumClos++)
 	{
+		const Closure& Clos = MesNoeudClos.GetClosure( NumClos);
+
 		// closures
-		std::vector<LatticePath>::const_iterator itClosedNodes = iteClos->second->ClosedNodes.begin();
+		std::vector<Subspace>::const_iterator itClosedNodes = Clos.ClosedNodes.begin();
 		PrintPath( *itClosedNodes, Cout);
-		for(++itClosedNodes ; itClosedNodes != iteClos->second->ClosedNodes.end(); ++itClosedNodes)
+		for(++itClosedNodes ; itClosedNodes != Clos.ClosedNodes.end(); ++itClosedNodes)
 		{
 			Cout << ',';
 			PrintPath( *itClosedNodes, Cout);
@@ -1207,13 +1070,14 @@ void ArbreCube::AfficheClos( std::ostream& Cout, std::vector<std::string>* Label
 
 		// skyline
 		Cout << " : ";
-		AfficheSkyline( iteClos->first.first, iteClos->first.second, false, Cout, Labels);
+		MesNoeudClos.GetSkyline( NumClos, D, I);
+		AfficheSkyline( D, I, false, Cout, Labels);
 
 		// generators
 		Cout << " : ";
-		std::vector<LatticePath>::const_iterator itgen = iteClos->second->Generators.begin();
+		std::vector<Subspace>::const_iterator itgen = Clos.Generators.begin();
 		PrintPath( *itgen, Cout);
-		for( ++itgen; itgen != iteClos->second->Generators.end(); ++itgen)
+		for( ++itgen; itgen != Clos.Generators.end(); ++itgen)
 		{
 			Cout << ',';
 			PrintPath( *itgen, Cout);
@@ -1224,29 +1088,33 @@ void ArbreCube::AfficheClos( std::ostream& Cout, std::vector<std::string>* Label
 }
 
 
-std::ostream& ArbreCube::PrintPath( const std::vector<long>& Chemin, std::ostream& Cout)
+template<typename T>
+std::ostream& ArbreCube<T>::PrintPath( Subspace Chemin, std::ostream& Cout)
 {
-	for( std::vector<long>::const_iterator reve = Chemin.begin(); reve != Chemin.end(); ++reve)
-		Cout << 'd' << (*reve);
+	for( ; Chemin != 0; Chemin &= Chemin - 1)
+		Cout << 'd' << LowestDimension( Chemin);
 	return Cout;
 }
 
 
-void ArbreCube::HashStat(std::ostream& Cout) const
+template<typename T>
+void ArbreCube<T>::HashStat(std::ostream& Cout) const
 {
-	Cout << MesNoeudClos.bucket_count() << " buckets :";
-	for( size_t nbBuckets = 0; nbBuckets < MesNoeudClos.bucket_count(); ++nbBuckets)
-		Cout << " " << MesNoeudClos.bucket_size(nbBuckets);
-	Cout << std::endl;
+	MesNoeudClos.Stats( Cout);
 }
 
 
-size_t ArbreCube::GetNbClos() const {
+template<typename T>
+size_t ArbreCube<T>::GetNbClos() const {
 	size_t total = 0;
-	for( HashClosure::const_iterator iteL = MesNoeudClos.begin(); iteL != MesNoeudClos.end(); ++iteL) {
-		total += iteL->second->ClosedNodes.size();
+	for( size_t NumClos = 0; NumClos < MesNoeudClos.Size(); NumClos++) {
+		total += MesNoeudClos.GetClosure( NumClos).ClosedNodes.size();
 	}
 	return total;
 }
 
 
+template class ArbreCube<double>;
+template class ArbreCube<uint32_t>;
+template class ArbreCube<float>;
+template class ArbreCube<int32_t>;
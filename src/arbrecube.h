@@ -23,116 +23,143 @@
 
 
 #include <map>
-#include <boost/unordered_map.hpp>
 #include <boost/pool/poolfwd.hpp>
 #include <boost/pool/pool_alloc.hpp>
 
 #include "defs.h"
+#include "dedup.h"
+#include "closuretable.h"
+#include "labels.h"
+#include "pointarena.h"
+#include "dominance.h"
+#include "skytree.h"
 #include "stx/btree_multimap.h"
 #include "utils.h"
 
 
+/*
+ * Node of the lattice built by the breadth algorithms
+ * The nodes of a level are allocated together, in the lexicographic order of their dimensions,
+ * so that the node of a subspace is found from its rank (see CreateParentsList)
+ * The skyline is stored in a PointArena: the distinct points then, for each group of combined
+ * points, its size followed by its points
+ */
 struct Noeud {
-	Noeud( unsigned long NbEnfants, unsigned long PathSize) :
-		EstType1( false),
-		EstComplet( false),
-		cs_D( 0),
-		cs_I( 0)
-	{
-		enfants.reserve( NbEnfants);
-		Chemin.reserve( PathSize);
-	}
+	// copies the content of TempD and TempI in Points, TempD and TempI are left empty
+	void Fill_D_I( DotSet& TempD, CombinedSkyline& TempI, PointArena& Points);
 
-	~Noeud()
-	{
-		std::for_each( enfants.begin(), enfants.end(), DeleteObject());
-	}
+	PointRange cs_D() const					{ return PointRange( Skyline, Skyline + NbD); }
+	GroupList cs_I() const					{ return GroupList( Skyline + NbD, Skyline + Taille, NbGroupes); }
 
-	void Fill_D_I( const DotSet& TempD, const CombinedSkyline& TempI);
+	Subspace Chemin;
 
-	Noeud* parent;
-	std::vector<Noeud*> enfants;
-	long offset;
+	const PointId* Skyline;
+	PointId NbD;
+	PointId NbGroupes;
+	PointId Taille;
+
+	int32_t offset;
 	bool EstType1;
 	bool EstComplet;		// all points are in D
-
-	std::vector<long> Chemin;
-
-	CompactSet	cs_D;
-	CompactComb	cs_I;
-
-	DotSet depthD;
-	CombinedSkyline depthI;
 };
 
-struct Closure {
-	Closure(const LatticePath& path, long NombreDimensions);
-
-	void AddElement(const LatticePath& path);
-
-	std::vector<LatticePath> ClosedNodes;
-	std::vector<LatticePath> Generators;
-
-	std::vector<bool> PrunedDimensions;
-};
-
-struct ClosureHash : public std::unary_function<HashKey,size_t>
-{
-	std::size_t operator()(const HashKey& n) const
+// node of the depth algorithm, which only keeps the current branch
+struct NoeudProfondeur {
+	NoeudProfondeur( Subspace Chemin_p, long offset_p, bool EstType1_p) :
+		Chemin( Chemin_p),
+		offset( offset_p),
+		EstType1( EstType1_p)
 	{
-		std::size_t seed = 0;
-		boost::hash_combine(seed, boost::hash_range(n.first.begin(), n.first.end()));
-		for(HashKey::second_type::const_iterator iteI = n.second.begin(); iteI != n.second.end(); ++iteI)
-			boost::hash_combine(seed, boost::hash_range(iteI->begin(), iteI->end()));
-
-		return seed;
 	}
-};
 
-struct ClosureEq : public std::binary_function<HashKey,HashKey,bool>
-{
-	bool operator()(const HashKey& n1, const HashKey& n2) const
-	{
-		return n1.first == n2.first && n1.second == n2.second;
-	}
+	Subspace Chemin;
+	long offset;
+	bool EstType1;
 };
 
-typedef boost::unordered_map<HashKey,Closure*,ClosureHash,ClosureEq> HashClosure;
-
 
 struct UnParent
 {
-	Noeud* Parent;
-	long RemovedDim;
+	const Noeud* Parent;
+	DimId RemovedDim;
 };
 
 typedef std::vector<UnParent,boost::fast_pool_allocator<UnParent> > ParentsList;
 
 struct UnDotSet
 {
-	const CompactSet* CombDotSet;
-	long RemovedDim;
+	PointRange CombDotSet;
+	DimId RemovedDim;
 };
 
 typedef std::vector<UnDotSet,boost::fast_pool_allocator<UnDotSet> > UnDotSetList;
 
+// scratch of one thread generating a level of the breadth algorithms
+struct BrouillonNiveau
+{
+	BrouillonNiveau() : NbType1( 0) {}
 
-enum PointOrderRelation { P1_DOM_P2, P2_DOM_P1, EQUIV, UNCOMP };
+	ParentsList ListeComposantes;
+	UnDotSetList VecUDS;
+	LatticePath Dimensions;
+	DotSet TempD;
+	CombinedSkyline TempI;
 
+	unsigned long NbType1;
+};
 
+
+/*
+ * T is the type of the coordinates stored in matrice (double, uint32_t for rank-transformed data,
+ * float or int32_t when a narrower storage has been chosen)
+ */
+template<typename T>
 class ArbreCube
 {
 public:
-	ArbreCube( const double* matrice_p, const std::vector<bool>& FindLowest, long NombrePoints_p, long NombreDimensions_p);
+	typedef stx::btree_multimap<T,PointId> BTree;
+
+	ArbreCube( const T* matrice_p, const std::vector<bool>& FindLowest, long NombrePoints_p, long NombreDimensions_p);
 	~ArbreCube();
 
 	bool LoadClosures( std::istream& Cin);
 
+	/*
+	 * The matrix holds one point per group of identical elements of the data set,
+	 * the groups are expanded back when displaying the result
+	 */
+	void SetPointGroups( const PointGroups* Groupes_p)	{ Groupes = Groupes_p; }
+
+	/*
+	 * Makes the dominance tests (and Sum) read a row-major copy of matrice
+	 * aligned on cache lines, so that the values of one point are next to each other
+	 * The B+-trees and Step_3_1 keep reading the columns of matrice
+	 */
+	void UseRowMajor();
+
+	/*
+	 * Chooses how the skylines left to BNL are filtered, SKY_SFS sorting the candidates first
+	 * so that the window never has to drop a point, SKY_BSKYTREE partitioning them around
+	 * pivots (PartitionSkyline, always used for the node of all dimensions)
+	 */
+	void SetSkylineAlgo( SKYLINE_ALGO Algo)				{ AlgoSkyline = Algo; }
+
+	// threads sharing the skyline of the node of all dimensions (ParallelSkyline) and the nodes
+	// of each level of the breadth algorithms
+	void SetNbThreads( unsigned NbThreads_p)			{ NbThreads = NbThreads_p; }
+
+	/*
+	 * Makes the breadth algorithms write each level to Flux as soon as it is generated, in the
+	 * order of AfficheResultat, and free it once the next level is done: only level 1 and the
+	 * last two levels stay in memory, so AfficheResultat can't be used afterwards
+	 */
+	void SetResultStream( std::ostream* Flux, const LabelArena* Labels)	{ FluxResultat = Flux; LabelsFlux = Labels; }
+
 	void DepthAlgo( bool ComputeLast);
 	void BreadthAlgo( bool UseClosure);
 
-	void AfficheResultat( std::ostream& Cout_Resultat, std::vector<std::string>* Labels) const;
-	void AfficheClos( std::ostream& Cout, std::vector<std::string>* Labels) const;
+	void AfficheResultat( std::ostream& Cout_Resultat, const LabelArena* Labels) const;
+	void AfficheClos( std::ostream& Cout, const LabelArena* Labels) const;
 
 	// makes sense only for depth algo
 	unsigned long GetNbProcessedNodes()	const		{ return Compteur; }
@@ -142,26 +169,31 @@ public:
 	uint64_t GetNbSkylineFoundDirectly() const		{ return NbSkylineFoundDirectly; }
 	uint64_t GetNbSkylineFoundByBNL() const			{ return NbSkylineFoundTotal; }
 
-	static std::ostream& PrintPath( const std::vector<long>& Chemin, std::ostream& Cout);
+	static std::ostream& PrintPath( Subspace Chemin, std::ostream& Cout);
 
-	template<typename T>
-	static void PrintD(const T& TempD, std::ostream& Cout);
+	template<typename TD>
+	static void PrintD(const TD& TempD, std::ostream& Cout);
 	template<typename TI, typename TD>
 	static void PrintI(const TI& TempI, std::ostream& Cout);
 
+	// load factor and probe lengths of the closure table
 	void HashStat( std::ostream& Cout) const;
 
 private:
 	void GenereBTrees();
 	void GenereDimension1(bool depth);
-	void GenereDimensionProf( const Noeud& ParentNoeud, const DotSet& pcsD, const CombinedSkyline& pcsI, Closure* ParentGroup = 0);
+	void GenereDimensionProf( const NoeudProfondeur& ParentNoeud, const DotSet& pcsD, const CombinedSkyline& pcsI, Closure* ParentGroup = 0);
 	void GenereDimensionN( unsigned long DimNumber);
 
+	// generates the nodes of a level, see GenereDimensionN
+	class GenerationNiveau;
+
 	/*
-	 * Determines whether TempNoeud is of type 1 and fills it accordingly
+	 * Determines whether the node is of type 1, in which case EstType1 is set and TempD or TempI filled
+	 * The caller counts the type 1 nodes
 	 */
 	template<class _D, class _I, class D2, class I2>
-	void ManageType1( Noeud* TempNoeud,
+	void ManageType1( bool& EstType1,
 								DotSet& TempD,
 								CombinedSkyline& TempI,
 								const _D& pcsD,
@@ -177,8 +209,8 @@ private:
 		 */
 		void Depth_Step_2_1( DotSet& TempD,
 							CombinedSkyline& TempI,
-							const Noeud* ParentNoeud,
-							const Noeud* TempNewDim);
+							const NoeudProfondeur* ParentNoeud,
+							long NewDim);
 
 		/*
 		 * This step processes the new dimension's node's sets of combined points to remove those
@@ -187,30 +219,43 @@ private:
 		 */
 		void Depth_Step_2_2( DotSet& TempD,
 							CombinedSkyline& TempI,
-							const Noeud* TempNewDim,
-							const std::vector<long>& Path);
+							long NewDim,
+							const LatticePath& Path);
 
 		/*
 		 * This method is used in Step 3.1 to unite elements which belong
 		 * to the computed intervals
 		 */
 		void Union( DotSet& sk,
-					stx::btree_multimap<double,long>::const_iterator& iteLowerBound,
-					stx::btree_multimap<double,long>::const_iterator& iteUpperBound);
+					typename BTree::const_iterator& iteLowerBound,
+					typename BTree::const_iterator& iteUpperBound);
 
 		/*
 		 * Compute the node of all dimensions
 		 * Useful for closures since this node will by definition alway be a closure
 		 * Can accelerate a bit the creation of the left-most branch of the tree
 		 */
-		const Noeud* ComputeLastNode();
+		void ComputeLastNode();
 
 	// breadth-related methods
 		/*
 		 * This method creates a list of all the direct parents of the current node
 		 * Each element of a list comprises the parent node and the missing dimension compared to the actual node
 		 */
-		void CreateParentsList( Noeud* TempNoeud, ParentsList& ListeComposantes);
+		void CreateParentsList( const LatticePath& Chemin, ParentsList& ListeComposantes);
+
+		/*
+		 * Generates the nodes of level DimNumber dealt to thread NumThread out of NbParts, by packets
+		 * of consecutive nodes, their skylines going to the arena of that thread
+		 */
+		void GenereEnfants( unsigned long DimNumber, unsigned NumThread, unsigned NbParts, BrouillonNiveau& Brouillon);
+
+		// computes the skyline of TempNoeud, child of TempParent through NewDim
+		void GenereNoeud(	Noeud& TempNoeud,
+							const Noeud& TempParent,
+							long NewDim,
+							BrouillonNiveau& Brouillon,
+							PointArena& Arena);
 
 		/*
 		 * This step simplifies the list of combined sets by removing those
@@ -218,7 +263,6 @@ private:
 		 */
 		void Breadth_Step_2_1(	UnDotSetList& VecUDS,
 								const ParentsList& ListeComposantes,
-								const Noeud* TempNoeud,
 								const DotSet& TempD);
 
 		/*
@@ -235,7 +279,7 @@ private:
 		 * Every dimension set is intersected with each other
 		 * Remaining elements are added in node's skyline
 		 */
-		void RangeBNL( const Noeud* TempNoeud, DotSet& TempD, CombinedSkyline& TempI);
+		void RangeBNL( const LatticePath& Chemin, DotSet& TempD, CombinedSkyline& TempI);
 
 		/*
 		 * Visit every dimension and for each of them define an interval from which to pick up elements
@@ -245,20 +289,15 @@ private:
 		void Step_3_1(	DotSet& TempDotSet,
 						const DotSet& TempD,
 						const CombinedSkyline& TempI,
-						const std::vector<long>& Path);
-
-		/*
-		 * Copies the contents of Stockage into D and I of TempNoeud
-		 */
-		void Step_3_3( const std::list<DotSet>& Stockage, DotSet& TempD, CombinedSkyline& TempI);
+						const LatticePath& Path);
 
 		/*
 		 * This method is used in Step 3.1 to compute the intersection
 		 * of elements which belong to the computed intervals
 		 */
 		void Intersection(	DotSet& sk,
-							stx::btree_multimap<double,long>::const_iterator& iteLowerBound,
-							stx::btree_multimap<double,long>::const_iterator& iteUpperBound);
+							typename BTree::const_iterator& iteLowerBound,
+							typename BTree::const_iterator& iteUpperBound);
 
 
 	/*
@@ -276,41 +315,49 @@ private:
 	bool AreDisjoint( In first, In last, In2 first2, In2 last2);
 
 	/*
-	 * Compares P1 and P2 on the dimensions provided by Chemin. Returns:
-	 * - P1_DOM_P2 if P1 dominates P2
-	 * - P2_DOM_P1 if P2 dominates P1
-	 * - EQUIV if they are combined
-	 * - UNCOMP if they aren't comparable
-	 */
-	PointOrderRelation ComparePoints( long P1, long P2, const std::vector<long>& Chemin);
-
-	/*
-	 * Compares all elements from TempDotSet and ResultDotSet between them
+	 * Compares the elements from first to last to each other and to those of TempD and TempI
 	 * Chemin provides the list of dimensions on which to compare the elements
-	 * Stores the result in ResultDotSet
+	 * Stores the skyline in TempD and TempI
+	 * The elements already in TempD and TempI must be part of the skyline
 	 */
 	template<class In>
-	void BNL( In first, In last, const std::vector<long>& Chemin, std::list<DotSet>& ResultDotSet);
+	void BNL( In first, In last, const LatticePath& Chemin, DotSet& TempD, CombinedSkyline& TempI);
 
 	// domain-related methods
 		/*
 		 * Main method that loads SP and calls Evaluate for every element of a selected B+-tree
 		 */
-		void TakeTheBus( DotSet& TempD, CombinedSkyline& TempI, const Noeud* TempNoeud);
+		void TakeTheBus( DotSet& TempD, CombinedSkyline& TempI, const LatticePath& Chemin);
+
+		/*
+		 * Evaluates the elements of a B+-tree from first to last, except those of Omega
+		 * The elements tied on the dimension of the tree are sorted with SortForSFS, none of them
+		 * can then dominate an element evaluated before it, whatever their order in the tree
+		 */
+		template<class It>
+		long EvaluateAll(	It first,
+							It last,
+							const DotSet& Omega,
+							std::multimap<double,PointId> &SP,
+							const LatticePath& Chemin,
+							const PathComparator<T>& ComparePoints,
+							DotSet& TempD,
+							CombinedSkyline& TempI);
 
 		/*
 		 * Evaluate compares the element to those of SP by the way of the sum its values on the selected dimensions
 		 */
-		long Evaluate(	long NumPoint,
-						std::multimap<double,long> &SP,
-						const std::vector<long>& Chemin,
+		long Evaluate(	PointId NumPoint,
+						std::multimap<double,PointId> &SP,
+						const LatticePath& Chemin,
+						const PathComparator<T>& ComparePoints,
 						DotSet& TempD,
 						CombinedSkyline& TempI);
 
 		/*
 		 * Computes the sum of an element's values on the selected dimensions
 		 */
-		double Sum( long NumPoint, const std::vector<long>& Chemin);
+		double Sum( PointId NumPoint, const LatticePath& Chemin);
 
 		/*
 		 * Returns the domain size of a dimension (max - min)
@@ -329,68 +376,103 @@ private:
 		 *
 		 * Distinct and combined properties matter here
 		 */
-		template<class T>
-		bool IncludedIn( const Noeud* TempNoeud, const T& VecNoeuds);
+		template<class TN>
+		bool IncludedIn( const Noeud* TempNoeud, const TN& VecNoeuds);
 
 		/*
 		 *
 		 */
 		template<class InputIterator>
-		bool PathIncludedIn(InputIterator begin, InputIterator end, const std::vector<long>& myPath);
+		bool PathIncludedIn(InputIterator begin, InputIterator end, Subspace myPath);
 
-		/*
-		 * Returns the node for which Skyline(TempNoeud) == Skyline(N), for any N element of VecNoeuds
-		 * Returns null otherwise
-		 *
-		 * Distinct and combined properties matter here
-		 */
-		Closure* FindClosure(const HashKey& keyToFind, const HashClosure& VecNoeuds);
+	// every thread has its own arenas, level k >= 2 sharing them with the levels of the same
+	// parity, which are freed first
+	PointArena& ArenaNiveau( long NumDim, unsigned NumThread)
+	{
+		return *SkylinesNoeuds[ (NumDim == 1 ? 0 : 1 + NumDim % 2) * NbThreads + NumThread];
+	}
 
 	// display methods
-	void AfficheLargeur(std::vector<Noeud*>& Pile,
+	void AfficheNiveau(	size_t NumDim,
 						std::ostream& Cout,
-						std::vector<std::string>* Labels) const;
-	void AfficheNoeud(	const Noeud *TempNoeud,
-						std::vector<Noeud*>& Pile,
+						const LabelArena* Labels) const;
+
+	void AfficheNoeud(	const Noeud& TempNoeud,
 						std::ostream& Cout,
-						std::vector<std::string>* Labels) const;
+						const LabelArena* Labels) const;
 
 	template<class _D, class _I>
 	void AfficheSkyline(const _D& cs_D,
 						const _I& cs_I,
 						bool isComplete,
 						std::ostream& Cout,
-						std::vector<std::string>* Labels) const;
+						const LabelArena* Labels) const;
+
+	template<class _D, class _I>
+	void PrintSkyline(	const _D& cs_D,
+						const _I& cs_I,
+						std::ostream& Cout,
+						const LabelArena* Labels) const;
+
+	/*
+	 * Replaces every point by its group of identical elements: a distinct point with
+	 * duplicates becomes a set of combined elements
+	 */
+	template<class _D, class _I>
+	void ExpandGroups(	const _D& cs_D,
+						const _I& cs_I,
+						CompactSet& ExpandedD,
+						CompactComb& ExpandedI) const;
 
 	ALGO CurrentAlgo;
-	const double* const matrice;
+	const T* const matrice;
 	const long NombrePoints;
 	const long NombreDimensions;
 	const std::vector<bool>& FindLowest;
 
-	std::vector<int> FindLowest1;
-	std::vector<int> FindLowest2;
+	// value of point P on dimension i for the dominance tests: VueDominance[i*PasDimension + P*PasPoint]
+	T* Lignes;					// row-major copy of matrice, if used
+	const T* VueDominance;
+	long PasDimension;
+	long PasPoint;
+
+	bool AllLowest;				// no 'u' dimension, no need to look at the orientation
+	SKYLINE_ALGO AlgoSkyline;
+	unsigned NbThreads;
 
 	Cnk MyCnk;
 	std::vector<double> domainSize;
 
-	std::vector<stx::btree_multimap<double,long> > VecBtree;
+	std::vector<BTree> VecBtree;
+
+	ClosureTable MesNoeudClos;
 
-	HashClosure MesNoeudClos;
+	// breadth: level k holds the Cnk(k) nodes of k dimensions, their skylines being in the
+	// ArenaNiveau(k, ...) (level 0 stays empty)
+	std::vector<std::vector<Noeud> > Niveaux;
+	std::vector<PointArena*> SkylinesNoeuds;
+
+	// streamed output of the breadth levels, if any
+	std::ostream* FluxResultat;
+	const LabelArena* LabelsFlux;
+
+	// depth: skylines of the single dimensions
+	std::vector<DotSet> depthD;
+	std::vector<CombinedSkyline> depthI;
 
-	Noeud* racine;
-	const Noeud* lastNode;
-	std::vector<Noeud*> PileNm1;
 	unsigned long Compteur;					// processed nodes
 	unsigned long Type1Count;
 	uint64_t NbSkylineFoundDirectly;
 	uint64_t NbSkylineFoundTotal;
 	bool isLastNodeFirst;	 				// whether to compute the last node first (only relevant for depth)
+
+	const PointGroups* Groupes;
 };
 
 
+template<typename T>
 template<class In, class In2>
-bool ArbreCube::AreDisjoint( In first, In last, In2 first2, In2 last2) {
+bool ArbreCube<T>::AreDisjoint( In first, In last, In2 first2, In2 last2) {
 	if( first == last || first2 == last2)
 		return true;
 
@@ -409,71 +491,107 @@ bool ArbreCube::AreDisjoint( In first, In last, In2 first2, In2 last2) {
 }
 
 
+template<typename T>
 template<class In>
-void ArbreCube::BNL( In first, In last, const std::vector<long>& Chemin, std::list<DotSet>& ResultDotSet)
+void ArbreCube<T>::BNL( In first, In last, const LatticePath& Chemin, DotSet& TempD, CombinedSkyline& TempI)
 {
-	std::vector<long>::const_iterator iteChemin;
-	std::list<DotSet>::iterator iteResult;
+	DominanceWindow<T> Fenetre( VueDominance, PasDimension, PasPoint, FindLowest, Chemin);
 
-	DotSet EmptyDotSet;
-	bool MustInsert;
+	for( DotSet::const_iterator iteD = TempD.begin(); iteD != TempD.end(); ++iteD)
+		Fenetre.Add( *iteD);
+	for( CombinedSkyline::const_iterator iteI = TempI.begin(); iteI != TempI.end(); ++iteI)
+		Fenetre.Add( *iteI);
 
-	for( ; first != last; ++first)
+	if( AlgoSkyline == SKY_BSKYTREE)
 	{
-		MustInsert = true;
+		// the known skyline points are partitioned with the others
+		std::vector<PointId> Candidats( first, last);
+		Candidats.insert( Candidats.end(), TempD.begin(), TempD.end());
+		for( CombinedSkyline::const_iterator iteI = TempI.begin(); iteI != TempI.end(); ++iteI)
+			Candidats.insert( Candidats.end(), iteI->begin(), iteI->end());
+
+		TempD.clear();
+		TempI.clear();
+		PartitionSkyline<T>( VueDominance, PasDimension, PasPoint, FindLowest, Chemin).Compute( Candidats, TempD, TempI);
+		return;
+	}
 
-		for( iteResult = ResultDotSet.begin(); iteResult != ResultDotSet.end(); )
-		{
-			PointOrderRelation ResultComp = ComparePoints( *first, *((*iteResult).begin()), Chemin);
+	if( AlgoSkyline == SKY_SFS)
+	{
+		std::vector<PointId> Candidats( first, last);
+		SortForSFS( VueDominance, PasDimension, PasPoint, FindLowest, Chemin, Candidats);
+		for( std::vector<PointId>::const_iterator iteCandidat = Candidats.begin(); iteCandidat != Candidats.end(); ++iteCandidat)
+			Fenetre.Append( *iteCandidat);
+	}
+	else
+		for( ; first != last; ++first)
+			Fenetre.Insert( *first);
 
-			if( ResultComp == P2_DOM_P1)
-			{
-				MustInsert = false;
-				break;
-			}
-			if( ResultComp == EQUIV)
-			{
-				(*iteResult).insert( *first);
-				MustInsert = false;
-				break;
-			}
-			if( ResultComp == P1_DOM_P2)
-				ResultDotSet.erase( iteResult++);
-			else
-				++iteResult;
-		}
+	TempD.clear();
+	TempI.clear();
+	Fenetre.Extract( TempD, TempI);
+}
+
+
+template<typename T>
+template<class It>
+long ArbreCube<T>::EvaluateAll(	It first,
+								It last,
+								const DotSet& Omega,
+								std::multimap<double,PointId> &SP,
+								const LatticePath& Chemin,
+								const PathComparator<T>& ComparePoints,
+								DotSet& TempD,
+								CombinedSkyline& TempI)
+{
+	long count = 0;
+	std::vector<PointId> Egaux;
 
-		if( MustInsert)
-			ResultDotSet.insert( ResultDotSet.begin(), EmptyDotSet)->insert( *first);
+	while( first != last)
+	{
+		const T Valeur = first.key();
+		Egaux.clear();
+		for( ; first != last && first.key() == Valeur; ++first)
+			if( Omega.find( first.data()) == Omega.end())
+				Egaux.push_back( first.data());
+
+		if( Egaux.size() > 1)
+			SortForSFS( VueDominance, PasDimension, PasPoint, FindLowest, Chemin, Egaux);
+		for( std::vector<PointId>::const_iterator iteEgal = Egaux.begin(); iteEgal != Egaux.end(); ++iteEgal)
+			count += Evaluate( *iteEgal, SP, Chemin, ComparePoints, TempD, TempI);
 	}
+
+	return count;
 }
 
 
+template<typename T>
 template<class In, class In2>
-void ArbreCube::Flatten( In first, In last, In2 first2, In2 last2, DotSet& Result)
+void ArbreCube<T>::Flatten( In first, In last, In2 first2, In2 last2, DotSet& Result)
 {
-	for( ; first != last; ++first)
-		Result.insert( *first);
-
+	std::vector<PointId> Points( first, last);
 	for( ; first2 != last2; ++first2)
-		Result.insert( first2->begin(), first2->end());
+		Points.insert( Points.end(), first2->begin(), first2->end());
+	Result.insert( Points.begin(), Points.end());
 }
 
+template<typename T>
 template<class InputIterator>
-bool ArbreCube::PathIncludedIn(InputIterator begin, InputIterator end, const std::vector<long>& myPath) {
+bool ArbreCube<T>::PathIncludedIn(InputIterator begin, InputIterator end, Subspace myPath) {
 	for( ; begin != end; ++begin) {
-		if(std::includes((*begin)->Chemin.begin(), (*begin)->Chemin.end(), myPath.begin(), myPath.end()))
+		if(IsSubspaceOf(myPath, (*begin)->Chemin))
 			return true;
 	}
 	return false;
 }
 
 template<typename T>
-void ArbreCube::PrintD(const T& TempD, std::ostream& Cout) {
+template<typename TD>
+void ArbreCube<T>::PrintD(const TD& TempD, std::ostream& Cout) {
 	if( TempD.empty())
 		return;
 
-	typename T::const_iterator iteDs = TempD.begin();
+	typename TD::const_iterator iteDs = TempD.begin();
 	for(;;)
 	{
 		Cout << 'e' << (*iteDs) + 1;
@@ -485,8 +603,9 @@ void ArbreCube::PrintD(const T& TempD, std::ostream& Cout) {
 }
 
 
+template<typename T>
 template<typename TI,typename TD>
-void ArbreCube::PrintI(const TI& TempI, std::ostream& Cout) {
+void ArbreCube<T>::PrintI(const TI& TempI, std::ostream& Cout) {
 	if( TempI.empty())
 		return;
 
@@ -510,8 +629,9 @@ void ArbreCube::PrintI(const TI& TempI, std::ostream& Cout) {
 	}
 }
 
+template<typename T>
 template<class _D, class _I, class D2, class I2>
-void ArbreCube::ManageType1( Noeud* TempNoeud,
+void ArbreCube<T>::ManageType1( bool& EstType1,
 							DotSet& TempD,
 							CombinedSkyline& TempI,
 							const _D& pcsD,
@@ -521,14 +641,14 @@ void ArbreCube::ManageType1( Noeud* TempNoeud,
 {
 	if( ! pcsD.empty())
 	{
-		long D_Value = *(pcsD.begin());
+		PointId D_Value = *(pcsD.begin());
 
 		if( ! newDimD.empty())
 		{
 			if( D_Value == *(newDimD.begin()))
 			{
 				TempD.insert( D_Value);
-				TempNoeud->EstType1 = true;
+				EstType1 = true;
 			}
 		}
 		else
@@ -538,7 +658,7 @@ void ArbreCube::ManageType1( Noeud* TempNoeud,
 									D_Value) )
 			{
 				TempD.insert( D_Value);
-				TempNoeud->EstType1 = true;
+				EstType1 = true;
 			}
 		}
 	}
@@ -546,14 +666,14 @@ void ArbreCube::ManageType1( Noeud* TempNoeud,
 	{
 		if( ! newDimD.empty())
 		{
-			long D_Value = *(newDimD.begin());
+			PointId D_Value = *(newDimD.begin());
 
 			if( std::binary_search( (*(pcsI.begin())).begin(),
 									(*(pcsI.begin())).end(),
 									D_Value) )
 			{
 				TempD.insert( D_Value);
-				TempNoeud->EstType1 = true;
+				EstType1 = true;
 			}
 		}
 		else
@@ -568,7 +688,7 @@ void ArbreCube::ManageType1( Noeud* TempNoeud,
 			// type 1
 			if( ! TempDotSet.empty())
 			{
-				TempNoeud->EstType1 = true;
+				EstType1 = true;
 				if( TempDotSet.size() > 1)
 					TempI.insert( TempDotSet);
 				else
@@ -577,42 +697,64 @@ void ArbreCube::ManageType1( Noeud* TempNoeud,
 		}
 	}
 
-	if( TempNoeud->EstType1)
-		Type1Count++;
 }
 
 
+template<typename T>
 template<class _D, class _I>
-void ArbreCube::AfficheSkyline( const _D& cs_D,
+void ArbreCube<T>::AfficheSkyline( const _D& cs_D,
 								const _I& cs_I,
 								bool isComplete,
 								std::ostream& Cout,
-								std::vector<std::string>* Labels ) const
+								const LabelArena* Labels ) const
 {
 	if(isComplete)
 	{
+		const long NbElements = Groupes ? Groupes->NbOriginal() : NombrePoints;
 		if( Labels)
 		{
-			Cout << (*Labels)[0];
-			for( long i = 1; i < NombrePoints; i++)
-				Cout << ',' << (*Labels)[i];
+			Labels->Write( Cout, 0);
+			for( long i = 1; i < NbElements; i++)
+				{
+				Cout << ',';
+				Labels->Write( Cout, i);
+			}
 		}
 		else
 		{
 			Cout << "e0";
-			for( long i = 1; i < NombrePoints; i++)
+			for( long i = 1; i < NbElements; i++)
 				Cout << ',' << 'e' << i;
 		}
 		return;
 	}
 
+	if( Groupes)
+	{
+		CompactSet ExpandedD;
+		CompactComb ExpandedI;
+		ExpandGroups( cs_D, cs_I, ExpandedD, ExpandedI);
+		PrintSkyline( ExpandedD, ExpandedI, Cout, Labels);
+	}
+	else
+		PrintSkyline( cs_D, cs_I, Cout, Labels);
+}
+
+
+template<typename T>
+template<class _D, class _I>
+void ArbreCube<T>::PrintSkyline(	const _D& cs_D,
+								const _I& cs_I,
+								std::ostream& Cout,
+								const LabelArena* Labels ) const
+{
 	typename _D::const_iterator iteDs;
 	if( ! cs_D.empty())
 	{
 		for( iteDs = cs_D.begin();;)
 		{
 			if( Labels)
-				Cout << (*Labels)[*iteDs];
+				Labels->Write( Cout, *iteDs);
 			else
 				Cout << 'e' << (*iteDs);
 			if( ++iteDs != cs_D.end())
@@ -633,7 +775,7 @@ void ArbreCube::AfficheSkyline( const _D& cs_D,
 			for( iteDs = (*iteSk).begin();;)
 			{
 				if( Labels)
-					Cout << (*Labels)[*iteDs];
+					Labels->Write( Cout, *iteDs);
 				else
 					Cout << 'e' << (*iteDs);
 				if( ++iteDs != (*iteSk).end())
@@ -651,4 +793,32 @@ void ArbreCube::AfficheSkyline( const _D& cs_D,
 }
 
 
+template<typename T>
+template<class _D, class _I>
+void ArbreCube<T>::ExpandGroups(	const _D& cs_D,
+								const _I& cs_I,
+								CompactSet& ExpandedD,
+								CompactComb& ExpandedI) const
+{
+	// representatives are the smallest element of their group and keep their order
+	for( typename _D::const_iterator iteDs = cs_D.begin(); iteDs != cs_D.end(); ++iteDs)
+	{
+		if( Groupes->Size( *iteDs) == 1)
+			ExpandedD.push_back( *Groupes->Begin( *iteDs));
+		else
+			ExpandedI.push_back( CompactSet( Groupes->Begin( *iteDs), Groupes->End( *iteDs)));
+	}
+
+	for( typename _I::const_iterator iteSk = cs_I.begin(); iteSk != cs_I.end(); ++iteSk)
+	{
+		ExpandedI.push_back( CompactSet());
+		for( typename _I::value_type::const_iterator iteDs = (*iteSk).begin(); iteDs != (*iteSk).end(); ++iteDs)
+			ExpandedI.back().insert( ExpandedI.back().end(), Groupes->Begin( *iteDs), Groupes->End( *iteDs));
+		std::sort( ExpandedI.back().begin(), ExpandedI.back().end());
+	}
+
+	std::sort( ExpandedI.begin(), ExpandedI.end(), ltdotset());
+}
+
+
 #endif /*ARBRECUBE_H_*/
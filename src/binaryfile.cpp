@@ -0,0 +1,238 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "binaryfile.h"
+
+
+namespace {
+
+const char BinaryMagic[8] = { 'O', 'R', 'I', 'O', 'N', 'B', 'I', 'N' };
+const uint32_t BinaryVersion = 1;
+const uint32_t BinaryByteOrder = 0x01020304;
+const uint64_t BinaryAlignment = 64;
+
+uint64_t Align( uint64_t Offset)
+{
+	return (Offset + BinaryAlignment - 1) / BinaryAlignment * BinaryAlignment;
+}
+
+void Pad( std::ofstream& Sortie, uint64_t& Offset, uint64_t Target)
+{
+	static const char Zeros[BinaryAlignment] = { 0 };
+	Sortie.write( Zeros, Target - Offset);
+	Offset = Target;
+}
+
+}
+
+
+bool IsBinaryDataset( const char* FileName)
+{
+	if( strcmp( FileName, "-") == 0)
+		return false;
+
+	std::ifstream Entree( FileName, std::ios::in | std::ios::binary);
+	char Magic[sizeof(BinaryMagic)];
+	if( ! Entree.read( Magic, sizeof(Magic)))
+		return false;
+
+	return memcmp( Magic, BinaryMagic, sizeof(Magic)) == 0;
+}
+
+bool WriteBinaryDataset(	const char* FileName,
+							const double* matrice,
+							long NombrePoints,
+							long NombreDimensions,
+							const std::vector<bool>& FindLowest,
+							const LabelArena* Labels )
+{
+	std::ofstream Sortie( FileName, std::ios::out | std::ios::binary | std::ios::trunc);
+	if( ! Sortie.is_open())
+	{
+		std::cout << "Couldn't open file " << FileName << " for writing" << std::endl;
+		return false;
+	}
+
+	BinaryHeader Entete;
+	memset( &Entete, 0, sizeof(Entete));
+	memcpy( Entete.Magic, BinaryMagic, sizeof(BinaryMagic));
+	Entete.Version = BinaryVersion;
+	Entete.ByteOrder = BinaryByteOrder;
+	Entete.NombrePoints = NombrePoints;
+	Entete.NombreDimensions = NombreDimensions;
+
+	uint64_t Offset = sizeof(BinaryHeader);
+	if( ! FindLowest.empty())
+	{
+		Entete.Flags |= BinaryHeader::ORIENTATION;
+		Offset += NombreDimensions;
+	}
+	Entete.DataOffset = Align( Offset);
+
+	const uint64_t TailleColonnes = static_cast<uint64_t>(NombrePoints) * NombreDimensions * sizeof(double);
+	if( Labels)
+	{
+		Entete.Flags |= BinaryHeader::LABELS;
+		Entete.LabelsOffset = Align( Entete.DataOffset + TailleColonnes);
+	}
+
+	Sortie.write( reinterpret_cast<const char*>(&Entete), sizeof(Entete));
+	Offset = sizeof(BinaryHeader);
+
+	if( ! FindLowest.empty())
+	{
+		for( std::vector<bool>::const_iterator iteUL = FindLowest.begin(); iteUL != FindLowest.end(); ++iteUL)
+			Sortie.put( (*iteUL) ? 'l' : 'u');
+		Offset += NombreDimensions;
+	}
+
+	Pad( Sortie, Offset, Entete.DataOffset);
+	Sortie.write( reinterpret_cast<const char*>(matrice), TailleColonnes);
+	Offset += TailleColonnes;
+
+	if( Labels)
+	{
+		Pad( Sortie, Offset, Entete.LabelsOffset);
+
+		// the arena already has the layout of the file
+		Sortie.write( reinterpret_cast<const char*>(Labels->Offsets()), (NombrePoints + 1) * sizeof(uint64_t));
+		Sortie.write( Labels->Bytes(), Labels->Offsets()[NombrePoints]);
+	}
+
+	if( ! Sortie)
+	{
+		std::cout << "Error while writing " << FileName << std::endl;
+		return false;
+	}
+
+	std::cout << "Wrote " << NombrePoints << " elements in " << NombreDimensions << " dimensions to " << FileName << std::endl;
+	return true;
+}
+
+bool MapBinaryDataset(	const char* FileName,
+						MappedFile& Fichier,
+						const double*& matrice,
+						long& NombrePoints,
+						long& NombreDimensions,
+						std::vector<bool>& FindLowest,
+						LabelArena* Labels )
+{
+	if( ! Fichier.Open( FileName, false))
+		return false;
+
+	const char* Debut = Fichier.Data();
+	const uint64_t Taille = Fichier.Size();
+
+	BinaryHeader Entete;
+	if( Taille < sizeof(Entete))
+	{
+		std::cout << "Truncated binary header" << std::endl;
+		return false;
+	}
+	memcpy( &Entete, Debut, sizeof(Entete));
+
+	if( memcmp( Entete.Magic, BinaryMagic, sizeof(BinaryMagic)) != 0 || Entete.Version != BinaryVersion)
+	{
+		std::cout << "Unknown binary data set version" << std::endl;
+		return false;
+	}
+	if( Entete.ByteOrder != BinaryByteOrder)
+	{
+		std::cout << "Binary data set written with a different byte order" << std::endl;
+		return false;
+	}
+
+	// sizes are checked by divisions, the products of corrupted values could wrap around
+	if(	Entete.NombreDimensions == 0 || Entete.DataOffset % sizeof(double) != 0 ||
+		Entete.DataOffset < sizeof(Entete) || Entete.DataOffset > Taille ||
+		Entete.NombreDimensions > (Taille - Entete.DataOffset) / sizeof(double) ||
+		Entete.NombrePoints > (Taille - Entete.DataOffset) / (Entete.NombreDimensions * sizeof(double)) )
+	{
+		std::cout << "Truncated or corrupted binary data set" << std::endl;
+		return false;
+	}
+
+	// the orientation lies between the header and the data
+	if( (Entete.Flags & BinaryHeader::ORIENTATION) && Entete.NombreDimensions > Entete.DataOffset - sizeof(Entete))
+	{
+		std::cout << "Truncated or corrupted binary data set" << std::endl;
+		return false;
+	}
+
+	NombrePoints = Entete.NombrePoints;
+	NombreDimensions = Entete.NombreDimensions;
+
+	if( ! FindLowest.empty() && FindLowest.size() != static_cast<size_t>(NombreDimensions))
+	{
+		std::cout	<< "Different number of dimensions between the -s argument (" << FindLowest.size()
+					<< ") and the dataset (" << NombreDimensions << ")" << std::endl;
+		return false;
+	}
+
+	if( FindLowest.empty() && (Entete.Flags & BinaryHeader::ORIENTATION))
+	{
+		const char* Orientation = Debut + sizeof(Entete);
+		for( long i = 0; i < NombreDimensions; i++)
+			FindLowest.push_back( Orientation[i] != 'u');
+	}
+
+	if( Labels)
+	{
+		if( ! (Entete.Flags & BinaryHeader::LABELS))
+		{
+			std::cout << "No labels stored in the binary data set" << std::endl;
+			return false;
+		}
+
+		if(	Entete.LabelsOffset % sizeof(uint64_t) != 0 || Entete.LabelsOffset > Taille ||
+			Entete.NombrePoints >= (Taille - Entete.LabelsOffset) / sizeof(uint64_t) )
+		{
+			std::cout << "Truncated or corrupted binary data set" << std::endl;
+			return false;
+		}
+
+		const uint64_t TailleOffsets = (Entete.NombrePoints + 1) * sizeof(uint64_t);
+		const uint64_t TailleOctets = Taille - Entete.LabelsOffset - TailleOffsets;
+		const uint64_t* Offsets = reinterpret_cast<const uint64_t*>(Debut + Entete.LabelsOffset);
+		const char* Octets = Debut + Entete.LabelsOffset + TailleOffsets;
+
+		// every label has to lie within the byte area
+		bool Croissants = true;
+		for( long j = 0; Croissants && j < NombrePoints; j++)
+			Croissants = Offsets[j] <= Offsets[j+1];
+		if( ! Croissants || Offsets[NombrePoints] > TailleOctets)
+		{
+			std::cout << "Truncated or corrupted binary data set" << std::endl;
+			return false;
+		}
+
+		// the bytes of the labels are only read when writing the result
+		Labels->Attach( Offsets, Octets, NombrePoints);
+	}
+
+	matrice = reinterpret_cast<const double*>(Debut + Entete.DataOffset);
+
+	std::cout << "Mapped " << NombrePoints << " elements in " << NombreDimensions << " dimensions" << std::endl;
+	return true;
+}
@@ -0,0 +1,88 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef BINARYFILE_H_
+#define BINARYFILE_H_
+
+
+#include <stdint.h>
+#include <vector>
+
+#include "mappedfile.h"
+#include "labels.h"
+
+
+/*
+ * Binary data set layout (native byte order):
+ * - BinaryHeader,
+ * - if ORIENTATION is set, one 'l' or 'u' byte per dimension,
+ * - at DataOffset (64-byte aligned), NombreDimensions columns of NombrePoints doubles,
+ *   i.e. the value of point j on dimension i at i*NombrePoints + j, exactly what ArbreCube reads,
+ * - if LABELS is set, at LabelsOffset, NombrePoints+1 uint64_t offsets followed by the
+ *   label bytes (label j spans [offset j, offset j+1) of the byte area).
+ */
+struct BinaryHeader
+{
+	enum { ORIENTATION = 1, LABELS = 2 };
+
+	char Magic[8];					// "ORIONBIN"
+	uint32_t Version;
+	uint32_t ByteOrder;				// 0x01020304 as written by the producer
+	uint32_t Flags;
+	uint32_t Reserved;
+	uint64_t NombrePoints;
+	uint64_t NombreDimensions;
+	uint64_t DataOffset;
+	uint64_t LabelsOffset;
+};
+
+
+/*
+ * Returns true if FileName starts with the binary data set signature
+ */
+bool IsBinaryDataset( const char* FileName);
+
+/*
+ * Writes a column-major matrice (and optionally orientation and labels) as a binary data set
+ * FindLowest may be empty, in which case no orientation is stored
+ */
+bool WriteBinaryDataset(	const char* FileName,
+							const double* matrice,
+							long NombrePoints,
+							long NombreDimensions,
+							const std::vector<bool>& FindLowest,
+							const LabelArena* Labels );
+
+/*
+ * Maps a binary data set read-only, matrice and Labels point directly into the mapping which
+ * must stay open as long as they are used
+ * FindLowest is filled from the stored orientation if it is empty, otherwise it takes
+ * precedence and only its size is checked
+ */
+bool MapBinaryDataset(	const char* FileName,
+						MappedFile& Fichier,
+						const double*& matrice,
+						long& NombrePoints,
+						long& NombreDimensions,
+						std::vector<bool>& FindLowest,
+						LabelArena* Labels );
+
+
+#endif // BINARYFILE_H_
@@ -0,0 +1,239 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#include <algorithm>
+#include <iostream>
+
+#include "closuretable.h"
+
+
+// dimensions as letters, for debugging
+std::string Letters( Subspace Path) {
+	std::string Result;
+	for( ; Path != 0; Path &= Path - 1)
+		Result += static_cast<char>(LowestDimension( Path) + 65);
+	return Result;
+}
+
+
+Closure::Closure(Subspace path) :
+	PrunedDimensions( path)
+{
+	ClosedNodes.push_back(path);
+	Generators.push_back(path);
+#ifdef DEBUG_CLOS
+	std::cout << "New closure with " << Letters(path) << std::endl;
+#endif
+}
+
+void Closure::AddElement(Subspace path)
+{
+#ifdef DEBUG_CLOS
+	std::cout << "\t\tAddElement: " << Letters(path) << std::endl;
+#endif
+
+	std::vector<Subspace>::const_iterator iteClos = ClosedNodes.begin();
+	for( ; iteClos != ClosedNodes.end(); ++iteClos)
+	{
+#ifdef DEBUG_CLOS
+		std::cout << "\t\t(*iteClos): " << Letters(*iteClos) << std::endl;
+#endif
+		if( IsSubspaceOf( path, *iteClos))
+			break;
+	}
+
+	// The node belongs to the closure but isn't "closed" so it's a new closed node
+	if( iteClos == ClosedNodes.end())
+	{
+		ClosedNodes.push_back(path);
+
+		// Also update the dimensions to prune
+		PrunedDimensions |= path;
+#ifdef DEBUG_CLOS
+		std::cout << "Added as close" << std::endl;
+#endif
+		return;
+	}
+
+	// The node is "closed" so it could be a generator
+	std::vector<Subspace>::iterator iteNoeuds = Generators.begin();
+	while( iteNoeuds != Generators.end())
+	{
+#ifdef DEBUG_CLOS
+		std::cout << "\t\tGen: " << Letters(*iteNoeuds) << std::endl;
+#endif
+		// ok it isn't a generator, we just ignore it
+		if( *iteNoeuds != path && IsSubspaceOf( *iteNoeuds, path))
+		{
+#ifdef DEBUG_CLOS
+			std::cout << "\t\tIsn't gen" << std::endl;
+#endif
+			return;
+		}
+
+		if( *iteNoeuds != path && IsSubspaceOf( path, *iteNoeuds))
+		{
+#ifdef DEBUG_CLOS
+			std::cout << "\t\tErase " << Letters(*iteNoeuds) << std::endl;
+#endif
+			iteNoeuds = Generators.erase(iteNoeuds);
+		}
+		else
+			++iteNoeuds;
+	}
+#ifdef DEBUG_CLOS
+	std::cout << "\t\tAdded as generator" << std::endl;
+#endif
+	Generators.push_back( path);
+}
+
+
+ClosureTable::ClosureTable() :
+	NbRecherches( 0),
+	NbSondes( 0)
+{
+	Case Libre;
+	Libre.Numero = VIDE;
+	Cases.assign( 1024, Libre);
+	Masque = Cases.size() - 1;
+}
+
+Closure* ClosureTable::Find( const SkylineRef& Skyline)
+{
+	NbRecherches++;
+	for( size_t i = Skyline.Empreinte.Bas & Masque;; i = (i + 1) & Masque)
+	{
+		NbSondes++;
+		const Case& Courante = Cases[i];
+		if( Courante.Numero == VIDE)
+			return 0;
+		if( Courante.Empreinte == Skyline.Empreinte && SameSkyline( Skylines[Courante.Numero], Skyline))
+			return &Closures[Courante.Numero];
+	}
+}
+
+Closure* ClosureTable::Insert( const SkylineRef& Skyline, Subspace Chemin)
+{
+	if( (Closures.size() + 1) * 2 > Cases.size())
+		Grow();
+
+	size_t i = Skyline.Empreinte.Bas & Masque;
+	while( Cases[i].Numero != VIDE)
+		i = (i + 1) & Masque;
+
+	Cases[i].Empreinte = Skyline.Empreinte;
+	Cases[i].Numero = Closures.size();
+
+	Skylines.push_back( Store( Skyline));
+	Closures.push_back( Closure( Chemin));
+	return &Closures.back();
+}
+
+void ClosureTable::GetSkyline( size_t Numero, CompactSet& D, CompactComb& I) const
+{
+	const PointId* Stocke = Skylines[Numero];
+
+	D.assign( Stocke + 1, Stocke + 1 + *Stocke);
+	Stocke += 1 + *Stocke;
+
+	I.resize( *Stocke);
+	Stocke++;
+	for( CompactComb::iterator iteI = I.begin(); iteI != I.end(); ++iteI)
+	{
+		iteI->assign( Stocke + 1, Stocke + 1 + *Stocke);
+		Stocke += 1 + *Stocke;
+	}
+}
+
+void ClosureTable::Stats( std::ostream& Cout) const
+{
+	// distance of every closure to the slot its fingerprint points to
+	size_t Total = 0;
+	size_t Max = 0;
+	for( size_t i = 0; i < Cases.size(); i++)
+		if( Cases[i].Numero != VIDE)
+		{
+			const size_t Distance = (i - (Cases[i].Empreinte.Bas & Masque)) & Masque;
+			Total += Distance;
+			Max = std::max( Max, Distance);
+		}
+
+	Cout << Closures.size() << " closures in " << Cases.size() << " slots (load " << double( Closures.size()) / Cases.size() << ")";
+	Cout << ", displacement mean " << (Closures.empty() ? 0. : double( Total) / Closures.size()) << " max " << Max;
+	Cout << ", " << NbRecherches << " lookups probing " << (NbRecherches ? double( NbSondes) / NbRecherches : 0.) << " slots on average";
+}
+
+bool ClosureTable::SameSkyline( const PointId* Stocke, const SkylineRef& Skyline) const
+{
+	if( *Stocke != Skyline.D.size() || ! std::equal( Skyline.D.begin(), Skyline.D.end(), Stocke + 1))
+		return false;
+	Stocke += 1 + *Stocke;
+
+	if( *Stocke != Skyline.I.size())
+		return false;
+	Stocke++;
+	for( CombinedSkyline::const_iterator iteI = Skyline.I.begin(); iteI != Skyline.I.end(); ++iteI)
+	{
+		if( *Stocke != iteI->size() || ! std::equal( iteI->begin(), iteI->end(), Stocke + 1))
+			return false;
+		Stocke += 1 + *Stocke;
+	}
+	return true;
+}
+
+const PointId* ClosureTable::Store( const SkylineRef& Skyline)
+{
+	size_t Taille = 2 + Skyline.D.size() + Skyline.I.size();
+	for( CombinedSkyline::const_iterator iteI = Skyline.I.begin(); iteI != Skyline.I.end(); ++iteI)
+		Taille += iteI->size();
+
+	PointId* Debut = Points.Allocate( Taille);
+	PointId* Fin = Debut;
+	*Fin++ = Skyline.D.size();
+	Fin = std::copy( Skyline.D.begin(), Skyline.D.end(), Fin);
+	*Fin++ = Skyline.I.size();
+	for( CombinedSkyline::const_iterator iteI = Skyline.I.begin(); iteI != Skyline.I.end(); ++iteI)
+	{
+		*Fin++ = iteI->size();
+		Fin = std::copy( iteI->begin(), iteI->end(), Fin);
+	}
+
+	return Debut;
+}
+
+void ClosureTable::Grow()
+{
+	std::vector<Case> Anciennes( Cases.size() * 2);
+	Anciennes.swap( Cases);
+	Masque = Cases.size() - 1;
+	for( size_t i = 0; i < Cases.size(); i++)
+		Cases[i].Numero = VIDE;
+
+	// the fingerprints are kept, nothing is rehashed
+	for( size_t i = 0; i < Anciennes.size(); i++)
+		if( Anciennes[i].Numero != VIDE)
+		{
+			size_t j = Anciennes[i].Empreinte.Bas & Masque;
+			while( Cases[j].Numero != VIDE)
+				j = (j + 1) & Masque;
+			Cases[j] = Anciennes[i];
+		}
+}
@@ -0,0 +1,130 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#ifndef CLOSURETABLE_H_
+#define CLOSURETABLE_H_
+
+
+#include <stdint.h>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "defs.h"
+#include "fingerprint.h"
+#include "pointarena.h"
+
+
+// dimensions as letters, for debugging
+std::string Letters( Subspace Path);
+
+
+struct Closure {
+	Closure(Subspace path);
+
+	void AddElement(Subspace path);
+
+	std::vector<Subspace> ClosedNodes;
+	std::vector<Subspace> Generators;
+
+	Subspace PrunedDimensions;
+};
+
+
+/*
+ * Skyline of a node looked up in the closure table: only its fingerprint is computed,
+ * the sets are compared when the fingerprints match and copied when a closure is created
+ */
+struct SkylineRef
+{
+	SkylineRef( const DotSet& D_p, const CombinedSkyline& I_p) :
+		D( D_p),
+		I( I_p),
+		Empreinte( D_p, I_p)
+	{
+	}
+
+	const DotSet& D;
+	const CombinedSkyline& I;
+	Fingerprint Empreinte;
+};
+
+
+/*
+ * Closures indexed by the skyline they share
+ * Open addressing with linear probing over slots holding the fingerprint and the number of the
+ * closure, so that a probe only looks at the stored skyline when the fingerprints match
+ * The skylines are stored one after the other in a PointArena and the closures in a deque,
+ * neither of them moves once created
+ */
+class ClosureTable
+{
+public:
+	ClosureTable();
+
+	// the closure whose skyline is Skyline, 0 if there is none
+	Closure* Find( const SkylineRef& Skyline);
+
+	// creates the closure of Skyline, which must not be in the table yet
+	Closure* Insert( const SkylineRef& Skyline, Subspace Chemin);
+
+	size_t Size() const									{ return Closures.size(); }
+	bool Empty() const									{ return Closures.empty(); }
+
+	// closures in creation order
+	const Closure& GetClosure( size_t Numero) const		{ return Closures[Numero]; }
+	void GetSkyline( size_t Numero, CompactSet& D, CompactComb& I) const;
+
+	// load factor and probe lengths
+	void Stats( std::ostream& Cout) const;
+
+private:
+	ClosureTable( const ClosureTable&);
+	ClosureTable& operator=( const ClosureTable&);
+
+	struct Case
+	{
+		Fingerprint Empreinte;
+		uint32_t Numero;				// VIDE if the slot is free
+	};
+	enum { VIDE = 0xFFFFFFFF };
+
+	bool SameSkyline( const PointId* Stocke, const SkylineRef& Skyline) const;
+	const PointId* Store( const SkylineRef& Skyline);
+	void Grow();
+
+	std::vector<Case> Cases;			// a power of two of them, at most half used
+	size_t Masque;
+
+	std::deque<Closure> Closures;
+	// per closure: the number of distinct points, the points, the number of groups then
+	// the size and the points of each group
+	std::vector<const PointId*> Skylines;
+
+	PointArena Points;
+
+	uint64_t NbRecherches;
+	uint64_t NbSondes;
+};
+
+
+#endif // CLOSURETABLE_H_
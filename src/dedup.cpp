@@ -0,0 +1,190 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
+#include "dedup.h"
+
+
+namespace {
+
+uint64_t ValueBits( double Valeur)
+{
+	Valeur += 0.0;						// -0.0 and 0.0 are equal, they must hash the same
+	uint64_t Bits;
+	memcpy( &Bits, &Valeur, sizeof(Bits));
+	return Bits;
+}
+
+uint64_t ValueBits( float Valeur)
+{
+	Valeur += 0.0f;
+	uint32_t Bits;
+	memcpy( &Bits, &Valeur, sizeof(Bits));
+	return Bits;
+}
+
+uint64_t ValueBits( uint32_t Valeur)
+{
+	return Valeur;
+}
+
+uint64_t ValueBits( int32_t Valeur)
+{
+	return static_cast<uint32_t>(Valeur);
+}
+
+uint64_t Mix( uint64_t Hash, uint64_t Bits)
+{
+	Hash ^= Bits + 0x9e3779b97f4a7c15ULL + (Hash << 6) + (Hash >> 2);
+	Hash ^= Hash >> 31;
+	Hash *= 0xbf58476d1ce4e5b9ULL;
+	return Hash ^ (Hash >> 29);
+}
+
+template<typename T>
+bool SameRow( const T* matrice, long NombrePoints, long NombreDimensions, long P1, long P2)
+{
+	for( long i = 0; i < NombreDimensions; i++)
+		if( !( matrice[i*NombrePoints + P1] == matrice[i*NombrePoints + P2]))
+			return false;
+	return true;
+}
+
+}
+
+
+template<typename T>
+long FindDuplicateRows(	const T* matrice,
+						long NombrePoints,
+						long NombreDimensions,
+						PointGroups& Groupes )
+{
+	Groupes.Clear();
+
+	// hashes are computed a column at a time to read the matrix sequentially
+	std::vector<uint64_t> Hash( NombrePoints, 0);
+	for( long i = 0; i < NombreDimensions; i++)
+		for( long j = 0; j < NombrePoints; j++)
+			Hash[j] = Mix( Hash[j], ValueBits( matrice[i*NombrePoints + j]));
+
+	size_t NbSlots = 16;
+	while( NbSlots < 2 * static_cast<size_t>(NombrePoints))
+		NbSlots <<= 1;
+	std::vector<long> Slots( NbSlots, -1);		// representative row of each slot
+
+	// Representant[j] is the first row equal to row j
+	std::vector<long> Representant( NombrePoints);
+	long NbDistincts = 0;
+
+	for( long j = 0; j < NombrePoints; j++)
+	{
+		size_t Slot = Hash[j] & (NbSlots - 1);
+		for(;;)
+		{
+			long Occupant = Slots[Slot];
+			if( Occupant < 0)
+			{
+				Slots[Slot] = j;
+				Representant[j] = j;
+				NbDistincts++;
+				break;
+			}
+			if( Hash[Occupant] == Hash[j] && SameRow( matrice, NombrePoints, NombreDimensions, Occupant, j))
+			{
+				Representant[j] = Occupant;
+				break;
+			}
+			Slot = (Slot + 1) & (NbSlots - 1);
+		}
+	}
+
+	if( NbDistincts == NombrePoints)
+		return NombrePoints;
+
+	// rows of a group are chained in ascending order, groups are emitted in order of their representative
+	std::vector<long> Suivant( NombrePoints, -1);
+	std::vector<long> Dernier( NombrePoints);
+	for( long j = 0; j < NombrePoints; j++)
+	{
+		long Rep = Representant[j];
+		if( Rep != j)
+			Suivant[Dernier[Rep]] = j;
+		Dernier[Rep] = j;
+	}
+
+	std::vector<PointId> Membres;
+	for( long j = 0; j < NombrePoints; j++)
+	{
+		if( Representant[j] != j)
+			continue;
+
+		Membres.clear();
+		for( long k = j; k >= 0; k = Suivant[k])
+			Membres.push_back( k);
+		Groupes.AddGroup( &Membres[0], &Membres[0] + Membres.size());
+	}
+
+	return NbDistincts;
+}
+
+void PointGroups::ExpandThrough( const PointGroups& Reduction)
+{
+	PointGroups Resultat;
+	std::vector<PointId> Groupe;
+
+	for( long r = 0; r < NbGroups(); r++)
+	{
+		Groupe.clear();
+		for( const PointId* itePoint = Begin( r); itePoint != End( r); ++itePoint)
+			Groupe.insert( Groupe.end(), Reduction.Begin( *itePoint), Reduction.End( *itePoint));
+		std::sort( Groupe.begin(), Groupe.end());
+		Resultat.AddGroup( &Groupe[0], &Groupe[0] + Groupe.size());
+	}
+
+	Swap( Resultat);
+}
+
+template<typename T>
+void CompactRows(	const T* Source,
+					T* Destination,
+					long NombrePoints,
+					long NombreDimensions,
+					const PointGroups& Groupes )
+{
+	const long NbGroupes = Groupes.NbGroups();
+
+	// rows only move towards the beginning, so this works in place as well
+	for( long i = 0; i < NombreDimensions; i++)
+		for( long r = 0; r < NbGroupes; r++)
+			Destination[i*NbGroupes + r] = Source[i*NombrePoints + *Groupes.Begin( r)];
+}
+
+
+template long FindDuplicateRows( const double*, long, long, PointGroups&);
+template long FindDuplicateRows( const uint32_t*, long, long, PointGroups&);
+template void CompactRows( const double*, double*, long, long, const PointGroups&);
+template void CompactRows( const uint32_t*, uint32_t*, long, long, const PointGroups&);
+template long FindDuplicateRows( const float*, long, long, PointGroups&);
+template long FindDuplicateRows( const int32_t*, long, long, PointGroups&);
+template void CompactRows( const float*, float*, long, long, const PointGroups&);
+template void CompactRows( const int32_t*, int32_t*, long, long, const PointGroups&);
@@ -0,0 +1,91 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef DEDUP_H_
+#define DEDUP_H_
+
+
+#include <vector>
+
+#include "defs.h"
+
+
+/*
+ * Elements of the original data set behind each point of a reduced matrix
+ * Groups are stored one after the other in ascending order, group r being
+ * [Begin(r), End(r)); its first element is the representative kept in the matrix
+ */
+class PointGroups
+{
+public:
+	PointGroups() : Debut( 1, 0) {}
+
+	long NbGroups() const						{ return Debut.size() - 1; }
+	long NbOriginal() const						{ return Membres.size(); }
+
+	long Size( long Groupe) const				{ return Debut[Groupe+1] - Debut[Groupe]; }
+	const PointId* Begin( long Groupe) const	{ return &Membres[0] + Debut[Groupe]; }
+	const PointId* End( long Groupe) const		{ return &Membres[0] + Debut[Groupe+1]; }
+
+	void Clear()								{ Debut.assign( 1, 0); Membres.clear(); }
+	void Swap( PointGroups& Autre)				{ Debut.swap( Autre.Debut); Membres.swap( Autre.Membres); }
+
+	// groups have to be added in ascending order of their representative
+	void AddGroup( const PointId* first, const PointId* last)
+	{
+		Membres.insert( Membres.end(), first, last);
+		Debut.push_back( Membres.size());
+	}
+
+	/*
+	 * The groups being made of points of a matrix that was itself reduced by Reduction,
+	 * replaces every point by the elements behind it
+	 */
+	void ExpandThrough( const PointGroups& Reduction);
+
+private:
+	std::vector<long> Debut;
+	std::vector<PointId> Membres;
+};
+
+
+/*
+ * Hashes the full rows of the column-major matrice and groups identical ones
+ * Returns the number of distinct rows, Groupes is only filled if there are duplicates
+ */
+template<typename T>
+long FindDuplicateRows(	const T* matrice,
+						long NombrePoints,
+						long NombreDimensions,
+						PointGroups& Groupes );
+
+/*
+ * Copies the representative row of every group of Source into Destination, which holds
+ * Groupes.NbGroups() points afterwards. Destination can be Source itself
+ */
+template<typename T>
+void CompactRows(	const T* Source,
+					T* Destination,
+					long NombrePoints,
+					long NombreDimensions,
+					const PointGroups& Groupes );
+
+
+#endif // DEDUP_H_
@@ -22,16 +22,34 @@
 #define DEFS_H_
 
 
+#include <stdint.h>
 #include <vector>
 #include <list>
 #include <set>
 
 
-typedef std::set<long> DotSet;
+/*
+ * Number of a point of the data set, 32 bits unless built with ORION_LONG_POINTS for
+ * data sets of more than 4 billion points
+ */
+#ifdef ORION_LONG_POINTS
+typedef long PointId;
+#else
+typedef uint32_t PointId;
+#endif
+
+// number of a dimension
+typedef uint16_t DimId;
+
+
+#include "dotset.h"
 
+
+// also used to order expanded CompactSets the same way
 struct ltdotset
 {
-	bool operator()(const DotSet& s1, const DotSet& s2) const
+	template<class S>
+	bool operator()(const S& s1, const S& s2) const
 	{
 		if( s1.size() < s2.size())
 			return true;
@@ -39,8 +57,8 @@ struct ltdotset
 		if( s1.size() > s2.size())
 			return false;
 
-		DotSet::const_iterator iteS1 = s1.begin();
-		DotSet::const_iterator iteS2 = s2.begin();
+		typename S::const_iterator iteS1 = s1.begin();
+		typename S::const_iterator iteS2 = s2.begin();
 		while( iteS1 != s1.end())
 		{
 			if( *iteS1 < *iteS2)
@@ -61,18 +79,51 @@ typedef std::list<DotSet> TempCombined;
 
 
 // once the node is computed, store the result in more compact containers
-typedef std::vector<long> CompactSet;
+typedef std::vector<PointId> CompactSet;
 typedef std::vector<CompactSet> CompactComb;
 
 
 // for closures (and not only?)
-typedef std::vector<long> LatticePath;
+typedef std::vector<DimId> LatticePath;
 typedef std::pair<DotSet,CombinedSkyline> HashKey;
 
 
+/*
+ * Subspace of the lattice, bit i standing for dimension i, hence at most MAX_DIMENSIONS
+ * The set bits taken from the lowest one give the dimensions in increasing order, which is
+ * the order of the LatticePath handed to the dominance tests
+ */
+typedef uint64_t Subspace;
+const long MAX_DIMENSIONS = 64;
+
+inline Subspace DimensionBit( long Dimension)			{ return Subspace(1) << Dimension; }
+inline bool IsSubspaceOf( Subspace s1, Subspace s2)		{ return (s1 & ~s2) == 0; }
+inline long SubspaceSize( Subspace s)					{ return __builtin_popcountll( s); }
+inline long LowestDimension( Subspace s)				{ return __builtin_ctzll( s); }		// s must not be empty
+
+// all of the NbDimensions dimensions (1 to MAX_DIMENSIONS), also the number of non-empty subspaces
+inline Subspace FullSpace( long NbDimensions)			{ return ~Subspace(0) >> (MAX_DIMENSIONS - NbDimensions); }
+
+inline void ExpandSubspace( Subspace s, LatticePath& Chemin)
+{
+	Chemin.clear();
+	for( ; s != 0; s &= s - 1)
+		Chemin.push_back( LowestDimension( s));
+}
+
+
+// relation between two points on a subspace
+enum PointOrderRelation { P1_DOM_P2, P2_DOM_P1, EQUIV, UNCOMP };
+
 // type of algorithm used to generate the tree
 enum ALGO { DEPTH, BREADTH, BR_DOM };
 
+// how the skyline of a set of candidates is filtered
+enum SKYLINE_ALGO { SKY_BNL, SKY_SFS, SKY_BSKYTREE };
+
+// type of the coordinates during the computation
+enum STORAGE { STORE_DOUBLE, STORE_FLOAT, STORE_FIXED };
+
 
 struct DeleteObject
 {
@@ -0,0 +1,642 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+	#include <immintrin.h>
+#endif
+
+#include "dominance.h"
+
+
+namespace {
+
+/*
+ * Operations on a block of Largeur values used by the kernel
+ * Masks are converted to one bit per value by Bits
+ */
+template<typename T>
+struct ScalarLanes
+{
+	typedef T Data;
+	typedef int Mask;
+	enum { Largeur = 1 };
+
+	static Data Load( const T* p)				{ return *p; }
+	static Data Set( T Valeur)					{ return Valeur; }
+	static Mask Lt( Data a, Data b)				{ return a < b; }
+	static Mask Gt( Data a, Data b)				{ return b < a; }
+	static Mask Or( Mask a, Mask b)				{ return a | b; }
+	static Mask Zero()							{ return 0; }
+	static int Bits( Mask m)					{ return m; }
+};
+
+#if defined(__AVX2__)
+
+template<typename T> struct Lanes;
+
+template<>
+struct Lanes<double>
+{
+	typedef __m256d Data;
+	typedef __m256d Mask;
+	enum { Largeur = 4 };
+
+	static Data Load( const double* p)			{ return _mm256_loadu_pd( p); }
+	static Data Set( double Valeur)				{ return _mm256_set1_pd( Valeur); }
+	static Mask Lt( Data a, Data b)				{ return _mm256_cmp_pd( a, b, _CMP_LT_OQ); }
+	static Mask Gt( Data a, Data b)				{ return _mm256_cmp_pd( a, b, _CMP_GT_OQ); }
+	static Mask Or( Mask a, Mask b)				{ return _mm256_or_pd( a, b); }
+	static Mask Zero()							{ return _mm256_setzero_pd(); }
+	static int Bits( Mask m)					{ return _mm256_movemask_pd( m); }
+};
+
+template<>
+struct Lanes<float>
+{
+	typedef __m256 Data;
+	typedef __m256 Mask;
+	enum { Largeur = 8 };
+
+	static Data Load( const float* p)			{ return _mm256_loadu_ps( p); }
+	static Data Set( float Valeur)				{ return _mm256_set1_ps( Valeur); }
+	static Mask Lt( Data a, Data b)				{ return _mm256_cmp_ps( a, b, _CMP_LT_OQ); }
+	static Mask Gt( Data a, Data b)				{ return _mm256_cmp_ps( a, b, _CMP_GT_OQ); }
+	static Mask Or( Mask a, Mask b)				{ return _mm256_or_ps( a, b); }
+	static Mask Zero()							{ return _mm256_setzero_ps(); }
+	static int Bits( Mask m)					{ return _mm256_movemask_ps( m); }
+};
+
+template<>
+struct Lanes<int32_t>
+{
+	typedef __m256i Data;
+	typedef __m256i Mask;
+	enum { Largeur = 8 };
+
+	static Data Load( const int32_t* p)			{ return _mm256_loadu_si256( reinterpret_cast<const __m256i*>(p)); }
+	static Data Set( int32_t Valeur)			{ return _mm256_set1_epi32( Valeur); }
+	static Mask Lt( Data a, Data b)				{ return _mm256_cmpgt_epi32( b, a); }
+	static Mask Gt( Data a, Data b)				{ return _mm256_cmpgt_epi32( a, b); }
+	static Mask Or( Mask a, Mask b)				{ return _mm256_or_si256( a, b); }
+	static Mask Zero()							{ return _mm256_setzero_si256(); }
+	static int Bits( Mask m)					{ return _mm256_movemask_ps( _mm256_castsi256_ps( m)); }
+};
+
+// there is no unsigned comparison, flipping the sign bit keeps the order with a signed one
+template<>
+struct Lanes<uint32_t> : public Lanes<int32_t>
+{
+	static Data Load( const uint32_t* p)		{ return _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<const __m256i*>(p)), _mm256_set1_epi32( 0x80000000)); }
+	static Data Set( uint32_t Valeur)			{ return _mm256_set1_epi32( static_cast<int32_t>(Valeur ^ 0x80000000U)); }
+};
+
+#elif defined(__SSE2__)
+
+template<typename T> struct Lanes;
+
+template<>
+struct Lanes<double>
+{
+	typedef __m128d Data;
+	typedef __m128d Mask;
+	enum { Largeur = 2 };
+
+	static Data Load( const double* p)			{ return _mm_loadu_pd( p); }
+	static Data Set( double Valeur)				{ return _mm_set1_pd( Valeur); }
+	static Mask Lt( Data a, Data b)				{ return _mm_cmplt_pd( a, b); }
+	static Mask Gt( Data a, Data b)				{ return _mm_cmpgt_pd( a, b); }
+	static Mask Or( Mask a, Mask b)				{ return _mm_or_pd( a, b); }
+	static Mask Zero()							{ return _mm_setzero_pd(); }
+	static int Bits( Mask m)					{ return _mm_movemask_pd( m); }
+};
+
+template<>
+struct Lanes<float>
+{
+	typedef __m128 Data;
+	typedef __m128 Mask;
+	enum { Largeur = 4 };
+
+	static Data Load( const float* p)			{ return _mm_loadu_ps( p); }
+	static Data Set( float Valeur)				{ return _mm_set1_ps( Valeur); }
+	static Mask Lt( Data a, Data b)				{ return _mm_cmplt_ps( a, b); }
+	static Mask Gt( Data a, Data b)				{ return _mm_cmpgt_ps( a, b); }
+	static Mask Or( Mask a, Mask b)				{ return _mm_or_ps( a, b); }
+	static Mask Zero()							{ return _mm_setzero_ps(); }
+	static int Bits( Mask m)					{ return _mm_movemask_ps( m); }
+};
+
+template<>
+struct Lanes<int32_t>
+{
+	typedef __m128i Data;
+	typedef __m128i Mask;
+	enum { Largeur = 4 };
+
+	static Data Load( const int32_t* p)			{ return _mm_loadu_si128( reinterpret_cast<const __m128i*>(p)); }
+	static Data Set( int32_t Valeur)			{ return _mm_set1_epi32( Valeur); }
+	static Mask Lt( Data a, Data b)				{ return _mm_cmplt_epi32( a, b); }
+	static Mask Gt( Data a, Data b)				{ return _mm_cmpgt_epi32( a, b); }
+	static Mask Or( Mask a, Mask b)				{ return _mm_or_si128( a, b); }
+	static Mask Zero()							{ return _mm_setzero_si128(); }
+	static int Bits( Mask m)					{ return _mm_movemask_ps( _mm_castsi128_ps( m)); }
+};
+
+// there is no unsigned comparison, flipping the sign bit keeps the order with a signed one
+template<>
+struct Lanes<uint32_t> : public Lanes<int32_t>
+{
+	static Data Load( const uint32_t* p)		{ return _mm_xor_si128( _mm_loadu_si128( reinterpret_cast<const __m128i*>(p)), _mm_set1_epi32( 0x80000000)); }
+	static Data Set( uint32_t Valeur)			{ return _mm_set1_epi32( static_cast<int32_t>(Valeur ^ 0x80000000U)); }
+};
+
+#else
+
+template<typename T>
+struct Lanes : public ScalarLanes<T>
+{
+};
+
+#endif
+
+
+/*
+ * N is the number of dimensions when it is known at compile time (0 otherwise), the candidate
+ * is then broadcast once for all the blocks and the loop over the dimensions is unrolled
+ */
+template<typename T, class L, int N>
+bool CompareBlocks(	const T* Candidat,
+					const T* Fenetre,
+					long Capacite,
+					long NbPoints,
+					long NbDims,
+					const char* Inverse,
+					uint64_t* Dominant,
+					uint64_t* Domine,
+					uint64_t* Equivalent )
+{
+	const int Plein = (1 << L::Largeur) - 1;
+	const long Nb = N > 0 ? N : NbDims;
+
+	typename L::Data Diffuse[N > 0 ? N : 1];
+	for( int k = 0; k < N; k++)
+		Diffuse[k] = L::Set( Candidat[k]);
+
+	for( long e = 0; e < NbPoints; e += L::Largeur)
+	{
+		typename L::Mask Meilleur = L::Zero();		// the candidate is better on some dimension
+		typename L::Mask Pire = L::Zero();			// the candidate is worse on some dimension
+
+		for( long k = 0; k < Nb; k++)
+		{
+			typename L::Data c = N > 0 ? Diffuse[k] : L::Set( Candidat[k]);
+			typename L::Data v = L::Load( Fenetre + k * Capacite + e);
+			if( Inverse[k])
+			{
+				Meilleur = L::Or( Meilleur, L::Gt( c, v));
+				Pire = L::Or( Pire, L::Lt( c, v));
+			}
+			else
+			{
+				Meilleur = L::Or( Meilleur, L::Lt( c, v));
+				Pire = L::Or( Pire, L::Gt( c, v));
+			}
+
+			// every point of the block is incomparable
+			if( (L::Bits( Meilleur) & L::Bits( Pire)) == Plein)
+				break;
+		}
+
+		int Valides = NbPoints - e >= L::Largeur ? Plein : (1 << (NbPoints - e)) - 1;
+		int BitsMeilleur = L::Bits( Meilleur);
+		int BitsPire = L::Bits( Pire);
+
+		// blocks never straddle two words since Largeur divides 64
+		const long Mot = e / 64;
+		const int Decalage = e % 64;
+		if( Decalage == 0)
+			Dominant[Mot] = Domine[Mot] = Equivalent[Mot] = 0;
+		Dominant[Mot] |= static_cast<uint64_t>(BitsMeilleur & ~BitsPire & Valides) << Decalage;
+		Domine[Mot] |= static_cast<uint64_t>(BitsPire & ~BitsMeilleur & Valides) << Decalage;
+		Equivalent[Mot] |= static_cast<uint64_t>(~(BitsMeilleur | BitsPire) & Valides) << Decalage;
+
+		if( ((BitsPire & ~BitsMeilleur) | ~(BitsMeilleur | BitsPire)) & Valides)
+			return false;
+	}
+
+	return true;
+}
+
+// CompareBlocks for every number of dimensions up to 16, the first entry being the generic one
+template<typename T>
+struct Kernels
+{
+	typedef bool (*Kernel)( const T*, const T*, long, long, long, const char*, uint64_t*, uint64_t*, uint64_t*);
+
+	static Kernel Get( long NbDims)
+	{
+		static const Kernel Table[17] = {
+			CompareBlocks< T, Lanes<T>, 0 >,	CompareBlocks< T, Lanes<T>, 1 >,	CompareBlocks< T, Lanes<T>, 2 >,
+			CompareBlocks< T, Lanes<T>, 3 >,	CompareBlocks< T, Lanes<T>, 4 >,	CompareBlocks< T, Lanes<T>, 5 >,
+			CompareBlocks< T, Lanes<T>, 6 >,	CompareBlocks< T, Lanes<T>, 7 >,	CompareBlocks< T, Lanes<T>, 8 >,
+			CompareBlocks< T, Lanes<T>, 9 >,	CompareBlocks< T, Lanes<T>, 10 >,	CompareBlocks< T, Lanes<T>, 11 >,
+			CompareBlocks< T, Lanes<T>, 12 >,	CompareBlocks< T, Lanes<T>, 13 >,	CompareBlocks< T, Lanes<T>, 14 >,
+			CompareBlocks< T, Lanes<T>, 15 >,	CompareBlocks< T, Lanes<T>, 16 > };
+		return NbDims <= 16 ? Table[NbDims] : Table[0];
+	}
+};
+
+}
+
+
+template<typename T>
+bool CompareOneToMany(	const T* Candidat,
+						const T* Fenetre,
+						long Capacite,
+						long NbPoints,
+						long NbDims,
+						const char* Inverse,
+						uint64_t* Dominant,
+						uint64_t* Domine,
+						uint64_t* Equivalent )
+{
+	return Kernels<T>::Get( NbDims)( Candidat, Fenetre, Capacite, NbPoints, NbDims, Inverse, Dominant, Domine, Equivalent);
+}
+
+const char* DominanceKernelName()
+{
+#if defined(__AVX2__)
+	return "AVX2";
+#elif defined(__SSE2__)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+
+template<typename T>
+PathComparator<T>::PathComparator(	const T* Vue_p,
+									long PasDimension,
+									long PasPoint_p,
+									const std::vector<bool>& FindLowest,
+									const LatticePath& Chemin ) :
+	Vue( Vue_p),
+	PasPoint( PasPoint_p)
+{
+	for( LatticePath::const_iterator iteChemin = Chemin.begin(); iteChemin != Chemin.end(); ++iteChemin)
+	{
+		Decalages.push_back( *iteChemin * PasDimension);
+		Meilleur.push_back( FindLowest[*iteChemin] ? 0 : 1);
+		Pire.push_back( FindLowest[*iteChemin] ? 1 : 0);
+	}
+
+	static PointOrderRelation (PathComparator::* const Table[17])( PointId, PointId) const = {
+		&PathComparator::CompareAny,	&PathComparator::CompareN<1>,	&PathComparator::CompareN<2>,
+		&PathComparator::CompareN<3>,	&PathComparator::CompareN<4>,	&PathComparator::CompareN<5>,
+		&PathComparator::CompareN<6>,	&PathComparator::CompareN<7>,	&PathComparator::CompareN<8>,
+		&PathComparator::CompareN<9>,	&PathComparator::CompareN<10>,	&PathComparator::CompareN<11>,
+		&PathComparator::CompareN<12>,	&PathComparator::CompareN<13>,	&PathComparator::CompareN<14>,
+		&PathComparator::CompareN<15>,	&PathComparator::CompareN<16> };
+	Comparaison = Chemin.size() <= 16 ? Table[Chemin.size()] : Table[0];
+}
+
+static const PointOrderRelation CPtab[4] = { EQUIV , P1_DOM_P2 , P2_DOM_P1 , UNCOMP };
+
+template<typename T>
+template<int N>
+PointOrderRelation PathComparator<T>::CompareN( PointId P1, PointId P2) const
+{
+	const T* Point1 = Vue + P1 * PasPoint;
+	const T* Point2 = Vue + P2 * PasPoint;
+	unsigned Status = 0;
+
+	for( int k = 0; k < N; k++)
+	{
+		const T v1 = Point1[ Decalages[k] ];
+		const T v2 = Point2[ Decalages[k] ];
+		Status |= (unsigned(v1 < v2) << Meilleur[k]) | (unsigned(v2 < v1) << Pire[k]);
+	}
+
+	return CPtab[Status];
+}
+
+template<typename T>
+PointOrderRelation PathComparator<T>::CompareAny( PointId P1, PointId P2) const
+{
+	const T* Point1 = Vue + P1 * PasPoint;
+	const T* Point2 = Vue + P2 * PasPoint;
+	unsigned Status = 0;
+
+	for( size_t k = 0; Status != 3 && k < Decalages.size(); k++)
+	{
+		const T v1 = Point1[ Decalages[k] ];
+		const T v2 = Point2[ Decalages[k] ];
+		Status |= (unsigned(v1 < v2) << Meilleur[k]) | (unsigned(v2 < v1) << Pire[k]);
+	}
+
+	return CPtab[Status];
+}
+
+
+namespace {
+
+// SFS order: increasing score, then values compared dimension after dimension
+template<typename T>
+class OrdreSFS
+{
+public:
+	OrdreSFS( const T* Vue_p, long PasPoint_p, const std::vector<long>& Decalages_p, const std::vector<char>& Inverse_p) :
+		Vue( Vue_p), PasPoint( PasPoint_p), Decalages( Decalages_p), Inverse( Inverse_p)
+	{
+	}
+
+	bool operator()( const std::pair<double,PointId>& a, const std::pair<double,PointId>& b) const
+	{
+		if( a.first != b.first)
+			return a.first < b.first;
+
+		const T* Point1 = Vue + a.second * PasPoint;
+		const T* Point2 = Vue + b.second * PasPoint;
+		for( size_t k = 0; k < Decalages.size(); k++)
+		{
+			if( Point1[ Decalages[k] ] < Point2[ Decalages[k] ])
+				return ! Inverse[k];
+			if( Point2[ Decalages[k] ] < Point1[ Decalages[k] ])
+				return Inverse[k];
+		}
+		return a.second < b.second;
+	}
+
+private:
+	const T* Vue;
+	long PasPoint;
+	const std::vector<long>& Decalages;
+	const std::vector<char>& Inverse;
+};
+
+}
+
+template<typename T>
+void SortForSFS(	const T* Vue,
+					long PasDimension,
+					long PasPoint,
+					const std::vector<bool>& FindLowest,
+					const LatticePath& Chemin,
+					std::vector<PointId>& Points )
+{
+	std::vector<long> Decalages;
+	std::vector<char> Inverse;
+	for( LatticePath::const_iterator iteChemin = Chemin.begin(); iteChemin != Chemin.end(); ++iteChemin)
+	{
+		Decalages.push_back( *iteChemin * PasDimension);
+		Inverse.push_back( ! FindLowest[*iteChemin]);
+	}
+
+	std::vector< std::pair<double,PointId> > Scores( Points.size());
+	bool Indefini = false;
+	for( size_t i = 0; i < Points.size(); i++)
+	{
+		const T* Point = Vue + Points[i] * PasPoint;
+		double Total = 0;
+		for( size_t k = 0; k < Decalages.size(); k++)
+			Total += Inverse[k] ? -static_cast<double>(Point[ Decalages[k] ]) : static_cast<double>(Point[ Decalages[k] ]);
+		Scores[i] = std::make_pair( Total, Points[i]);
+		Indefini |= Total != Total;
+	}
+
+	// infinite values of opposite signs leave no usable score, the values alone still give an SFS order
+	if( Indefini)
+		for( size_t i = 0; i < Scores.size(); i++)
+			Scores[i].first = 0;
+
+	// the values are only looked at for equal scores
+	std::sort( Scores.begin(), Scores.end());
+	for( size_t Debut = 0, Fin; Debut < Scores.size(); Debut = Fin)
+	{
+		for( Fin = Debut + 1; Fin < Scores.size() && ! (Scores[Debut].first < Scores[Fin].first); Fin++)
+			;
+		if( Fin - Debut > 1)
+			std::sort( Scores.begin() + Debut, Scores.begin() + Fin, OrdreSFS<T>( Vue, PasPoint, Decalages, Inverse));
+	}
+	for( size_t i = 0; i < Points.size(); i++)
+		Points[i] = Scores[i].second;
+}
+
+
+template<typename T>
+DominanceWindow<T>::DominanceWindow(	const T* Vue_p,
+									long PasDimension_p,
+									long PasPoint_p,
+									const std::vector<bool>& FindLowest,
+									const LatticePath& Chemin_p ) :
+	Vue( Vue_p),
+	PasDimension( PasDimension_p),
+	PasPoint( PasPoint_p),
+	Chemin( Chemin_p),
+	Noyau( Kernels<T>::Get( Chemin_p.size())),
+	Capacite( 0),
+	Candidat( Chemin_p.size())
+{
+	for( LatticePath::const_iterator iteChemin = Chemin.begin(); iteChemin != Chemin.end(); ++iteChemin)
+		Inverse.push_back( ! FindLowest[*iteChemin]);
+}
+
+template<typename T>
+void DominanceWindow<T>::Load( PointId Point, T* Destination, long Pas) const
+{
+	const T* Valeur = Vue + Point * PasPoint;
+	for( size_t k = 0; k < Chemin.size(); k++)
+		Destination[k * Pas] = Valeur[Chemin[k] * PasDimension];
+}
+
+template<typename T>
+void DominanceWindow<T>::Grow()
+{
+	const long NouvelleCapacite = Capacite == 0 ? 64 : Capacite * 2;
+	std::vector<T> NouvellesValeurs( NouvelleCapacite * Chemin.size());
+	for( size_t k = 0; k < Chemin.size(); k++)
+		std::copy( Valeurs.begin() + k * Capacite, Valeurs.begin() + k * Capacite + Representants.size(), NouvellesValeurs.begin() + k * NouvelleCapacite);
+
+	Valeurs.swap( NouvellesValeurs);
+	Capacite = NouvelleCapacite;
+	Dominant.resize( Capacite / 64);
+	Domine.resize( Capacite / 64);
+	Equivalent.resize( Capacite / 64);
+}
+
+template<typename T>
+void DominanceWindow<T>::Add( PointId Point)
+{
+	if( static_cast<long>(Representants.size()) == Capacite)
+		Grow();
+
+	Load( Point, &Valeurs[Representants.size()], Capacite);
+	Representants.push_back( Point);
+	Chaines.push_back( -1);
+}
+
+template<typename T>
+void DominanceWindow<T>::Add( const DotSet& Groupe)
+{
+	DotSet::const_iterator itePoint = Groupe.begin();
+	Add( *itePoint);
+	for( ++itePoint; itePoint != Groupe.end(); ++itePoint)
+		Combine( Representants.size() - 1, *itePoint);
+}
+
+template<typename T>
+void DominanceWindow<T>::Combine( long Entree, PointId Point)
+{
+	Membres.push_back( std::make_pair( Point, Chaines[Entree]));
+	Chaines[Entree] = Membres.size() - 1;
+}
+
+// the elements combined with a removed entry are left in Membres, unreachable
+template<typename T>
+void DominanceWindow<T>::Remove( long Entree)
+{
+	const long Derniere = Representants.size() - 1;
+	if( Entree != Derniere)
+	{
+		Representants[Entree] = Representants[Derniere];
+		Chaines[Entree] = Chaines[Derniere];
+		for( size_t k = 0; k < Chemin.size(); k++)
+			Valeurs[k * Capacite + Entree] = Valeurs[k * Capacite + Derniere];
+	}
+	Representants.pop_back();
+	Chaines.pop_back();
+}
+
+/*
+ * Compares the point to the entries, returns false once it has been dropped or combined
+ * with an entry, otherwise Dominant tells which entries it dominates
+ */
+template<typename T>
+bool DominanceWindow<T>::Compare( PointId Point)
+{
+	const long NbEntrees = Representants.size();
+	if( NbEntrees == 0)
+		return true;
+
+	Load( Point, &Candidat[0], 1);
+	if( Noyau( &Candidat[0], &Valeurs[0], Capacite, NbEntrees, Chemin.size(), &Inverse[0],
+				&Dominant[0], &Domine[0], &Equivalent[0]))
+		return true;
+
+	// the entries are mutually incomparable: a dominated or combined candidate dominates nothing
+	for( long Mot = 0; Mot * 64 < NbEntrees; Mot++)
+		if( Equivalent[Mot] != 0)
+		{
+			Combine( Mot * 64 + __builtin_ctzll( Equivalent[Mot]), Point);
+			break;
+		}
+		else if( Domine[Mot] != 0)
+			break;
+	return false;
+}
+
+template<typename T>
+void DominanceWindow<T>::Insert( PointId Point)
+{
+	const long NbEntrees = Representants.size();
+	if( ! Compare( Point))
+		return;
+
+	// from the end so that the entries moved by Remove have already been looked at
+	for( long Mot = (NbEntrees + 63) / 64 - 1; Mot >= 0; Mot--)
+		for( uint64_t Bits = Dominant[Mot]; Bits != 0; )
+		{
+			const int Bit = 63 - __builtin_clzll( Bits);
+			Remove( Mot * 64 + Bit);
+			Bits &= ~(uint64_t(1) << Bit);
+		}
+
+	Add( Point);
+}
+
+template<typename T>
+void DominanceWindow<T>::Append( PointId Point)
+{
+	if( Compare( Point))
+		Add( Point);
+}
+
+template<typename T>
+void DominanceWindow<T>::Extract( DotSet& TempD, CombinedSkyline& TempI) const
+{
+	std::vector<PointId> Seuls;
+	DotSet Groupe;
+
+	for( size_t Entree = 0; Entree < Representants.size(); Entree++)
+	{
+		if( Chaines[Entree] == -1)
+		{
+			Seuls.push_back( Representants[Entree]);
+			continue;
+		}
+
+		Groupe.clear();
+		Groupe.insert( Representants[Entree]);
+		for( long Membre = Chaines[Entree]; Membre != -1; Membre = Membres[Membre].second)
+			Groupe.insert( Membres[Membre].first);
+		TempI.insert( Groupe);
+	}
+
+	// sorted, every insertion is done at the end of the set
+	std::sort( Seuls.begin(), Seuls.end());
+	TempD.insert( Seuls.begin(), Seuls.end());
+}
+
+template<typename T>
+void DominanceWindow<T>::Extract( std::vector<PointId>& Representants_p, std::vector< std::pair<PointId,PointId> >& Combines) const
+{
+	for( size_t Entree = 0; Entree < Representants.size(); Entree++)
+	{
+		Representants_p.push_back( Representants[Entree]);
+		for( long Membre = Chaines[Entree]; Membre != -1; Membre = Membres[Membre].second)
+			Combines.push_back( std::make_pair( Representants[Entree], Membres[Membre].first));
+	}
+}
+
+
+template bool CompareOneToMany( const double*, const double*, long, long, long, const char*, uint64_t*, uint64_t*, uint64_t*);
+template bool CompareOneToMany( const uint32_t*, const uint32_t*, long, long, long, const char*, uint64_t*, uint64_t*, uint64_t*);
+template bool CompareOneToMany( const float*, const float*, long, long, long, const char*, uint64_t*, uint64_t*, uint64_t*);
+template bool CompareOneToMany( const int32_t*, const int32_t*, long, long, long, const char*, uint64_t*, uint64_t*, uint64_t*);
+
+template void SortForSFS( const double*, long, long, const std::vector<bool>&, const LatticePath&, std::vector<PointId>&);
+template void SortForSFS( const uint32_t*, long, long, const std::vector<bool>&, const LatticePath&, std::vector<PointId>&);
+template void SortForSFS( const float*, long, long, const std::vector<bool>&, const LatticePath&, std::vector<PointId>&);
+template void SortForSFS( const int32_t*, long, long, const std::vector<bool>&, const LatticePath&, std::vector<PointId>&);
+
+template class PathComparator<double>;
+template class PathComparator<uint32_t>;
+template class PathComparator<float>;
+template class PathComparator<int32_t>;
+
+template class DominanceWindow<double>;
+template class DominanceWindow<uint32_t>;
+template class DominanceWindow<float>;
+template class DominanceWindow<int32_t>;
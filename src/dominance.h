@@ -0,0 +1,179 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#ifndef DOMINANCE_H_
+#define DOMINANCE_H_
+
+
+#include <stdint.h>
+#include <vector>
+
+#include "defs.h"
+
+
+/*
+ * Compares the point Candidat (NbDims values) to the NbPoints points of Fenetre, stored dimension
+ * after dimension (value of point e on the k-th dimension at k*Capacite + e, Capacite being a
+ * multiple of 64). Inverse[k] is set when the upper value is the better one on the k-th dimension
+ * One bit per point of the window is set in Dominant if the candidate dominates the point, in Domine
+ * if the point dominates the candidate and in Equivalent if they are combined
+ * The comparison stops at the first block of points where the candidate is dominated or combined,
+ * in which case the function returns false
+ * Blocks of points are compared at once with AVX2 or SSE2 when the compiler targets them
+ */
+template<typename T>
+bool CompareOneToMany(	const T* Candidat,
+						const T* Fenetre,
+						long Capacite,
+						long NbPoints,
+						long NbDims,
+						const char* Inverse,
+						uint64_t* Dominant,
+						uint64_t* Domine,
+						uint64_t* Equivalent );
+
+// name of the instruction set used by CompareOneToMany
+const char* DominanceKernelName();
+
+
+/*
+ * Compares two points on the dimensions of a path, once the offsets of the dimensions and their
+ * orientation are known. Returns:
+ * - P1_DOM_P2 if P1 dominates P2
+ * - P2_DOM_P1 if P2 dominates P1
+ * - EQUIV if they are combined
+ * - UNCOMP if they aren't comparable
+ * Paths of up to 16 dimensions get a fully unrolled, branch-free comparison
+ */
+template<typename T>
+class PathComparator
+{
+public:
+	// same layout as DominanceWindow
+	PathComparator(	const T* Vue,
+					long PasDimension,
+					long PasPoint,
+					const std::vector<bool>& FindLowest,
+					const LatticePath& Chemin );
+
+	PointOrderRelation operator()( PointId P1, PointId P2) const	{ return (this->*Comparaison)( P1, P2); }
+
+private:
+	template<int N>
+	PointOrderRelation CompareN( PointId P1, PointId P2) const;
+	PointOrderRelation CompareAny( PointId P1, PointId P2) const;
+
+	const T* const Vue;
+	const long PasPoint;
+	std::vector<long> Decalages;		// offset of the k-th dimension of the path in a point
+	std::vector<uint8_t> Meilleur;		// shift of the status bit set when P1 < P2 on the k-th dimension
+	std::vector<uint8_t> Pire;			// and when P1 > P2
+
+	PointOrderRelation (PathComparator::*Comparaison)( PointId P1, PointId P2) const;
+};
+
+
+/*
+ * Sort-Filter-Skyline presorting: orders Points so that none of them can dominate a point placed
+ * before it, by increasing sum of the values on Chemin (subtracted on the 'u' dimensions), ties
+ * being broken by comparing the values dimension after dimension
+ * The layout is the one of DominanceWindow
+ */
+template<typename T>
+void SortForSFS(	const T* Vue,
+					long PasDimension,
+					long PasPoint,
+					const std::vector<bool>& FindLowest,
+					const LatticePath& Chemin,
+					std::vector<PointId>& Points );
+
+
+/*
+ * BNL window whose points are kept contiguous, dimension after dimension, for CompareOneToMany
+ * Every entry is a group of combined elements represented by its first one, the others being
+ * chained aside, so that nothing but flat arrays is allocated until the skyline is extracted
+ * The order of the entries isn't kept: removing one moves the last entry to its place
+ */
+template<typename T>
+class DominanceWindow
+{
+public:
+	/*
+	 * The value of point P on dimension i is Vue[i*PasDimension + P*PasPoint], the points
+	 * are compared on the dimensions of Chemin
+	 */
+	DominanceWindow(	const T* Vue,
+						long PasDimension,
+						long PasPoint,
+						const std::vector<bool>& FindLowest,
+						const LatticePath& Chemin );
+
+	// adds a point or a group known not to be dominated by (nor combined with) the other entries
+	void Add( PointId Point);
+	void Add( const DotSet& Groupe);
+
+	// BNL step: the point is dropped, combined with an entry or added, removing those it dominates
+	void Insert( PointId Point);
+
+	/*
+	 * SFS step: the point is dropped, combined with an entry or added, the entries being known
+	 * not to be dominated by it (points sorted by SortForSFS, after the groups given to Add)
+	 */
+	void Append( PointId Point);
+
+	long Size() const									{ return Representants.size(); }
+
+	// the single points of the window go to TempD, the groups to TempI
+	void Extract( DotSet& TempD, CombinedSkyline& TempI) const;
+
+	// or the representatives to Representants, every other element being paired with its own
+	void Extract( std::vector<PointId>& Representants, std::vector< std::pair<PointId,PointId> >& Combines) const;
+
+private:
+	typedef bool (*Kernel)( const T*, const T*, long, long, long, const char*, uint64_t*, uint64_t*, uint64_t*);
+
+	void Load( PointId Point, T* Destination, long Pas) const;
+	void Grow();
+	void Remove( long Entree);
+	bool Compare( PointId Point);
+	void Combine( long Entree, PointId Point);
+
+	const T* const Vue;
+	const long PasDimension;
+	const long PasPoint;
+	const LatticePath& Chemin;
+	std::vector<char> Inverse;
+	Kernel Noyau;						// CompareOneToMany for the size of Chemin
+
+	std::vector<PointId> Representants;
+	std::vector<long> Chaines;			// per entry, last element of Membres combined with it (-1 if none)
+	std::vector< std::pair<PointId,long> > Membres;	// combined element and the previous one of its entry
+	std::vector<T> Valeurs;				// NbDims columns of Capacite values
+	long Capacite;
+
+	std::vector<T> Candidat;
+	std::vector<uint64_t> Dominant;
+	std::vector<uint64_t> Domine;
+	std::vector<uint64_t> Equivalent;
+};
+
+
+#endif // DOMINANCE_H_
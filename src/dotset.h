@@ -0,0 +1,197 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#ifndef DOTSET_H_
+#define DOTSET_H_
+
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+
+/*
+ * Set of point numbers kept sorted in a single vector: one allocation for the whole set instead
+ * of one per element, and merges walking contiguous memory instead of trees
+ * Inserting at the end is cheap, anywhere else moves the following elements, so the elements of
+ * a set better be gathered first and given to the bulk operations
+ * Included by defs.h once PointId is defined
+ */
+class DotSet
+{
+public:
+	typedef PointId value_type;
+	typedef PointId key_type;
+	typedef std::vector<PointId>::size_type size_type;
+	typedef std::vector<PointId>::const_iterator const_iterator;
+	typedef const_iterator iterator;
+
+	DotSet() {}
+
+	template<class In>
+	DotSet( In first, In last)							{ insert( first, last); }
+
+	const_iterator begin() const						{ return Elements.begin(); }
+	const_iterator end() const							{ return Elements.end(); }
+	size_type size() const								{ return Elements.size(); }
+	bool empty() const									{ return Elements.empty(); }
+	void clear()										{ Elements.clear(); }
+	void reserve( size_type Taille)						{ Elements.reserve( Taille); }
+	void swap( DotSet& Autre)							{ Elements.swap( Autre.Elements); }
+
+	const_iterator lower_bound( PointId Point) const		{ return std::lower_bound( begin(), end(), Point); }
+
+	const_iterator find( PointId Point) const
+	{
+		const_iterator itePoint = lower_bound( Point);
+		return itePoint != end() && *itePoint == Point ? itePoint : end();
+	}
+
+	size_type count( PointId Point) const					{ return find( Point) != end(); }
+
+	std::pair<iterator,bool> insert( PointId Point)
+	{
+		if( Elements.empty() || Elements.back() < Point)
+		{
+			Elements.push_back( Point);
+			return std::make_pair( end() - 1, true);
+		}
+
+		std::vector<PointId>::iterator itePoint = std::lower_bound( Elements.begin(), Elements.end(), Point);
+		if( *itePoint == Point)
+			return std::make_pair( iterator( itePoint), false);
+		return std::make_pair( iterator( Elements.insert( itePoint, Point)), true);
+	}
+
+	// for std::inserter, the hint is ignored
+	iterator insert( iterator, PointId Point)				{ return insert( Point).first; }
+
+	// any order, duplicates allowed
+	template<class In>
+	void insert( In first, In last)
+	{
+		const size_type Avant = Elements.size();
+		Elements.insert( Elements.end(), first, last);
+		Canonize( Avant);
+	}
+
+	size_type erase( PointId Point)
+	{
+		const_iterator itePoint = find( Point);
+		if( itePoint == end())
+			return 0;
+		erase( itePoint);
+		return 1;
+	}
+
+	iterator erase( iterator itePoint)					{ return Elements.erase( Elements.begin() + (itePoint - begin())); }
+
+	iterator erase( iterator first, iterator last)
+	{
+		return Elements.erase( Elements.begin() + (first - begin()), Elements.begin() + (last - begin()));
+	}
+
+	// keeps only the elements of the sorted range [first, last)
+	template<class In>
+	void Intersect( In first, In last)
+	{
+		std::vector<PointId>::iterator iteGarde = Elements.begin();
+		for( std::vector<PointId>::const_iterator itePoint = Elements.begin(); itePoint != Elements.end() && first != last;)
+		{
+			if( *itePoint < *first)
+				++itePoint;
+			else
+			{
+				if( *itePoint == *first)
+					*iteGarde++ = *itePoint++;
+				++first;
+			}
+		}
+		Elements.erase( iteGarde, Elements.end());
+	}
+
+	// drops the elements of the sorted range [first, last)
+	template<class In>
+	void Remove( In first, In last)
+	{
+		std::vector<PointId>::iterator iteGarde = Elements.begin();
+		std::vector<PointId>::const_iterator itePoint = Elements.begin();
+		while( itePoint != Elements.end() && first != last)
+		{
+			if( *itePoint < *first)
+				*iteGarde++ = *itePoint++;
+			else
+			{
+				if( *itePoint == *first)
+					++itePoint;
+				++first;
+			}
+		}
+		iteGarde = std::copy( itePoint, const_iterator( Elements.end()), iteGarde);
+		Elements.erase( iteGarde, Elements.end());
+	}
+
+	// hands the sorted elements over to Destination without spare capacity, the set being left empty
+	void Release( std::vector<PointId>& Destination)
+	{
+		if( Elements.capacity() == Elements.size())
+		{
+			Destination.clear();
+			Destination.swap( Elements);
+		}
+		else
+		{
+			std::vector<PointId>( Elements.begin(), Elements.end()).swap( Destination);
+			Elements.clear();
+		}
+	}
+
+	bool operator==( const DotSet& Autre) const			{ return Elements == Autre.Elements; }
+	bool operator!=( const DotSet& Autre) const			{ return Elements != Autre.Elements; }
+	bool operator<( const DotSet& Autre) const			{ return Elements < Autre.Elements; }
+
+private:
+	// sorts the elements appended from Avant on and merges them with the previous ones
+	void Canonize( size_type Avant)
+	{
+		std::vector<PointId>::iterator Milieu = Elements.begin() + Avant;
+		if( Milieu == Elements.end())
+			return;
+
+		bool Trie = true;
+		for( std::vector<PointId>::const_iterator itePoint = Milieu + 1; Trie && itePoint < Elements.end(); ++itePoint)
+			Trie = *(itePoint - 1) < *itePoint;
+		if( ! Trie)
+			std::sort( Milieu, Elements.end());
+
+		const bool Fusion = Milieu != Elements.begin() && ! (*(Milieu - 1) < *Milieu);
+		if( Fusion)
+			std::inplace_merge( Elements.begin(), Milieu, Elements.end());
+		if( Fusion || ! Trie)
+			Elements.erase( std::unique( Elements.begin(), Elements.end()), Elements.end());
+	}
+
+	std::vector<PointId> Elements;
+};
+
+
+#endif // DOTSET_H_
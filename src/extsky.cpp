@@ -0,0 +1,87 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include <algorithm>
+#include <stdint.h>
+
+#include "extsky.h"
+#include "dominance.h"
+
+
+template<typename T>
+long FindExtendedSkyline(	const T* matrice,
+							long NombrePoints,
+							long NombreDimensions,
+							const std::vector<bool>& FindLowest,
+							PointGroups& Groupes )
+{
+	Groupes.Clear();
+
+	// in SFS order a point can only be beaten by one seen before it, and since beating strictly
+	// is transitive, by one already kept
+	LatticePath Chemin;
+	for( long i = 0; i < NombreDimensions; i++)
+		Chemin.push_back( i);
+	std::vector<PointId> Points( NombrePoints);
+	for( long j = 0; j < NombrePoints; j++)
+		Points[j] = j;
+	SortForSFS( matrice, NombrePoints, 1, FindLowest, Chemin, Points);
+
+	std::vector<PointId> Retenus;
+	std::vector<T> Valeurs;				// the kept points, one after the other
+	std::vector<T> Candidat( NombreDimensions);
+
+	for( long j = 0; j < NombrePoints; j++)
+	{
+		for( long i = 0; i < NombreDimensions; i++)
+			Candidat[i] = matrice[i*NombrePoints + Points[j]];
+
+		bool Battu = false;
+		for( size_t r = 0; ! Battu && r < Retenus.size(); r++)
+		{
+			const T* Retenu = &Valeurs[r * NombreDimensions];
+			long i = 0;
+			while( i < NombreDimensions && (FindLowest[i] ? Retenu[i] < Candidat[i] : Candidat[i] < Retenu[i]))
+				i++;
+			Battu = i == NombreDimensions;
+		}
+
+		if( ! Battu)
+		{
+			Retenus.push_back( Points[j]);
+			Valeurs.insert( Valeurs.end(), Candidat.begin(), Candidat.end());
+		}
+	}
+
+	if( static_cast<long>(Retenus.size()) == NombrePoints)
+		return NombrePoints;
+
+	std::sort( Retenus.begin(), Retenus.end());
+	for( size_t r = 0; r < Retenus.size(); r++)
+		Groupes.AddGroup( &Retenus[r], &Retenus[r] + 1);
+
+	return Retenus.size();
+}
+
+
+template long FindExtendedSkyline( const double*, long, long, const std::vector<bool>&, PointGroups&);
+template long FindExtendedSkyline( const uint32_t*, long, long, const std::vector<bool>&, PointGroups&);
+template long FindExtendedSkyline( const float*, long, long, const std::vector<bool>&, PointGroups&);
+template long FindExtendedSkyline( const int32_t*, long, long, const std::vector<bool>&, PointGroups&);
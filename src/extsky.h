@@ -0,0 +1,45 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef EXTSKY_H_
+#define EXTSKY_H_
+
+
+#include <vector>
+
+#include "dedup.h"
+
+
+/*
+ * Finds the extended skyline of the column-major matrice: the points that no other point beats
+ * strictly on every dimension. Only they can be part of the skyline of a subspace, combined or
+ * not, the others can thus be dropped before computing the skycube
+ * Returns the number of such points, Groupes is only filled (one element per group) if some
+ * points are left out
+ */
+template<typename T>
+long FindExtendedSkyline(	const T* matrice,
+							long NombrePoints,
+							long NombreDimensions,
+							const std::vector<bool>& FindLowest,
+							PointGroups& Groupes );
+
+
+#endif // EXTSKY_H_
@@ -0,0 +1,83 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#ifndef FINGERPRINT_H_
+#define FINGERPRINT_H_
+
+
+#include <stdint.h>
+
+#include "defs.h"
+
+
+/*
+ * 128-bit fingerprint of a skyline (distinct points and groups of combined points)
+ * Every point has a pseudo-random key and the keys are summed, so the fingerprint doesn't depend
+ * on the order the points are added in. A group of combined points adds a mix of the sum of its
+ * members' keys, which tells {a,b},{c} from {a},{b,c} and from the distinct points a, b and c
+ * Equal skylines have equal fingerprints, the converse being only very likely
+ */
+struct Fingerprint
+{
+	Fingerprint() : Haut( 0), Bas( 0) {}
+	Fingerprint( const DotSet& D, const CombinedSkyline& I) : Haut( 0), Bas( 0)
+	{
+		for( DotSet::const_iterator iteD = D.begin(); iteD != D.end(); ++iteD)
+			Add( *iteD);
+		for( CombinedSkyline::const_iterator iteI = I.begin(); iteI != I.end(); ++iteI)
+			AddGroup( iteI->begin(), iteI->end());
+	}
+
+	void Add( PointId Point)
+	{
+		Haut += Mix( Point);
+		Bas += Mix( Point ^ 0x5bd1e9955bd1e995ULL);
+	}
+
+	template<class In>
+	void AddGroup( In first, In last)
+	{
+		Fingerprint Groupe;
+		for( ; first != last; ++first)
+			Groupe.Add( *first);
+		Haut += Mix( Groupe.Haut ^ (Groupe.Bas << 32 | Groupe.Bas >> 32));
+		Bas += Mix( Groupe.Bas + 0x9e3779b97f4a7c15ULL * Groupe.Haut);
+	}
+
+	bool operator==( const Fingerprint& Autre) const	{ return Haut == Autre.Haut && Bas == Autre.Bas; }
+	bool operator!=( const Fingerprint& Autre) const	{ return ! (*this == Autre); }
+
+	uint64_t Haut;
+	uint64_t Bas;
+
+private:
+	// splitmix64 finaliser
+	static uint64_t Mix( uint64_t x)
+	{
+		x += 0x9e3779b97f4a7c15ULL;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+		return x ^ (x >> 31);
+	}
+};
+
+
+#endif // FINGERPRINT_H_
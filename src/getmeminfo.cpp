@@ -20,6 +20,7 @@
 
 #include <cstdio>
 #include <sstream>
+#include <unistd.h>
 
 #include "getmeminfo.h"
 
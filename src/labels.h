@@ -0,0 +1,93 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef LABELS_H_
+#define LABELS_H_
+
+
+#include <stdint.h>
+#include <ostream>
+#include <vector>
+
+
+/*
+ * Labels of the elements stored one after the other in a single byte area,
+ * label j spanning [Offsets()[j], Offsets()[j+1]) of Bytes() (the layout of the
+ * binary data sets)
+ * The arena either owns its bytes or refers to labels stored elsewhere, e.g. in
+ * a mapped file which then has to stay open as long as the labels are used
+ */
+class LabelArena
+{
+public:
+	LabelArena() :
+		Positions( 1, 0),
+		PositionsExternes( 0),
+		OctetsExternes( 0),
+		NbExternes( 0)
+	{
+	}
+
+	void Reserve( long NbLabels)				{ Positions.reserve( NbLabels + 1); }
+
+	void Add( const char* Debut, const char* Fin)
+	{
+		Octets.insert( Octets.end(), Debut, Fin);
+		Positions.push_back( Octets.size());
+	}
+
+	void Append( const LabelArena& Autre)
+	{
+		const uint64_t Decalage = Octets.size();
+		for( long j = 1; j <= Autre.Size(); j++)
+			Positions.push_back( Decalage + Autre.Offsets()[j]);
+		Octets.insert( Octets.end(), Autre.Bytes(), Autre.Bytes() + Autre.Offsets()[Autre.Size()]);
+	}
+
+	// refers to NbLabels labels stored elsewhere without copying them, the caller checks the offsets
+	void Attach( const uint64_t* Offsets_p, const char* Bytes_p, long NbLabels)
+	{
+		Octets.clear();
+		Positions.assign( 1, 0);
+		PositionsExternes = Offsets_p;
+		OctetsExternes = Bytes_p;
+		NbExternes = NbLabels;
+	}
+
+	long Size() const							{ return PositionsExternes ? NbExternes : Positions.size() - 1; }
+	const uint64_t* Offsets() const				{ return PositionsExternes ? PositionsExternes : &Positions[0]; }
+	const char* Bytes() const					{ return OctetsExternes ? OctetsExternes : (Octets.empty() ? 0 : &Octets[0]); }
+
+	const char* Begin( long j) const			{ return Bytes() + Offsets()[j]; }
+	size_t Length( long j) const				{ return Offsets()[j+1] - Offsets()[j]; }
+
+	void Write( std::ostream& Cout, long j) const	{ Cout.write( Begin( j), Length( j)); }
+
+private:
+	std::vector<char> Octets;
+	std::vector<uint64_t> Positions;		// Size()+1 entries, the first one being 0
+
+	const uint64_t* PositionsExternes;
+	const char* OctetsExternes;
+	long NbExternes;
+};
+
+
+#endif // LABELS_H_
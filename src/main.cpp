@@ -18,10 +18,16 @@
  */
 
 
+#include <cstdlib>
 #include <cstring>
 #include <vector>
 
 #include "readfile.h"
+#include "binaryfile.h"
+#include "rank.h"
+#include "narrow.h"
+#include "dedup.h"
+#include "extsky.h"
 #include "arbrecube.h"
 #include "getmeminfo.h"
 
@@ -43,42 +49,419 @@
 				"\t\t\t- br_dom : breadth + domain optimizations\n\n"\
 				"  -nolast\t\tDoes not compute the node of all dimensions first\n"\
 				"\t\t\tApplies only to depth algorithm, no effect otherwise\n\n"\
-				"  -h,--help\t\tDisplays this help message\n\n\n"\
+				"  -j THREADS\t\tNumber of threads used (by default: 1)\n"\
+				"\t\t\tApplies to the loading of the data set, to the skyline\n"\
+				"\t\t\tof the node of all dimensions and to each level of\n"\
+				"\t\t\tbreadth and br_dom\n\n"\
+				"  -rank\t\t\tReplaces the values of each dimension by their rank\n"\
+				"\t\t\t(lower is better) before computing, which halves the\n"\
+				"\t\t\tmemory of the matrix without changing the result\n\n"\
+				"  -store TYPE={double,float,fixed:SCALE}\n"\
+				"\t\t\tType of the coordinates during the computation (by\n"\
+				"\t\t\tdefault: double). fixed stores the values multiplied\n"\
+				"\t\t\tby SCALE and rounded in 32-bit integers. The number of\n"\
+				"\t\t\tvalues merged by the conversion is displayed\n\n"\
+				"  -rowmajor\t\tKeeps a copy of the data set stored point by point\n"\
+				"\t\t\tfor the dominance tests, faster with many dimensions\n\n"\
+				"  -sky SKY={bnl,sfs,bskytree}\n"\
+				"\t\t\tFilters the remaining skylines (by default: bnl):\n"\
+				"\t\t\t- bnl : block nested loops in the order of the elements\n"\
+				"\t\t\t- sfs : block nested loops on the elements sorted by\n"\
+				"\t\t\t  sum of their values, no element leaves the window\n"\
+				"\t\t\t- bskytree : recursive partitioning around skyline\n"\
+				"\t\t\t  points, faster with depth on anti-correlated data\n\n"\
+				"  -dedup\t\t\tCollapses identical elements into one point before\n"\
+				"\t\t\tcomputing, they are expanded back in the result\n\n"\
+				"  -extsky\t\tOnly keeps the elements that no other one beats on\n"\
+				"\t\t\tevery dimension, the others can't be in any skyline\n\n"\
+				"  -stream\t\tWrites the result of breadth and br_dom level by level\n"\
+				"\t\t\twhile computing, only the single dimensions and the last\n"\
+				"\t\t\ttwo levels are kept in memory\n\n"\
+				"  -cols LIST\t\tOnly loads the given columns (counted from 0 without\n"\
+				"\t\t\tthe label one), in that order, e.g. 0,3,5-7\n"\
+				"\t\t\tThe -s argument then describes the selected columns\n\n"\
+				"  -where COL:MIN:MAX\tOnly loads the elements whose value on column COL\n"\
+				"\t\t\tis within [MIN, MAX], either bound can be left empty\n"\
+				"\t\t\tCan be repeated, only applies to text data sets\n\n"\
+				"  -convert OUTFILE\tConverts the text data set into the binary format\n"\
+				"\t\t\tstored in OUTFILE and exits (orientation and labels are\n"\
+				"\t\t\tkept). Binary data sets are recognized when loading\n"\
+				"\t\t\tand mapped without any parsing\n\n"\
+				"  -h,--help\t\tDisplays this help message\n\n"\
+				"Filename can be - to read the data set from the standard input\n\n\n"\
 				"Examples: UnifiedSkyCube -a depth -nolast -s uulluuluulluull dataset42.txt\n"\
 				"          UnifiedSkyCube -a breadth dataset51.txt\n\n"
 
 
-void OutputResult(	const ArbreCube& bouleau,
-					const std::vector<bool>& FindLowest,
-					ALGO SelectedAlgo,
-					std::string& FichierResultat,
-					std::vector<std::string>* Labels )
+/*
+ * Completes the result filename with the orientation and opens it in OutputStream
+ * Returns the stream to write the result to, the screen if the file can't be opened
+ */
+std::ostream& OpenResult(	const std::vector<bool>& FindLowest,
+							std::string& FichierResultat,
+							std::ofstream& OutputStream )
 {
 	for( std::vector<bool>::const_iterator iteUL = FindLowest.begin(); iteUL != FindLowest.end(); ++iteUL)
 		FichierResultat += (*iteUL) ? "l" : "u";
 	FichierResultat += ".res";
 
-	std::ofstream OutputStream( FichierResultat.c_str());
+	OutputStream.open( FichierResultat.c_str());
 	if( ! OutputStream.is_open())
 	{
 		std::cout << "Couldn't open file " << FichierResultat << " to store the result, sending to screen" << std::endl;
+		return std::cout;
+	}
 
-		if( SelectedAlgo == DEPTH)
-			bouleau.AfficheClos( std::cout, Labels);
-		else
-			bouleau.AfficheResultat( std::cout, Labels);
+	std::cout << "Saving result into file " << FichierResultat << std::endl;
+	return OutputStream;
+}
+
+
+template<typename T>
+void OutputResult(	const ArbreCube<T>& bouleau,
+					const std::vector<bool>& FindLowest,
+					ALGO SelectedAlgo,
+					std::string& FichierResultat,
+					const LabelArena* Labels )
+{
+	std::ofstream OutputStream;
+	std::ostream& Cout = OpenResult( FindLowest, FichierResultat, OutputStream);
+
+	if( SelectedAlgo == DEPTH)
+		bouleau.AfficheClos( Cout, Labels);
+	else
+		bouleau.AfficheResultat( Cout, Labels);
+}
+
+
+/*
+ * Runs the selected algorithm on Donnees and stores the result
+ * FindLowest is the orientation seen by the algorithm, Orientation the one given by the user
+ * (they differ once the data set has been rank-transformed)
+ * Groupes, if not null, gives the elements behind each point of a deduplicated Donnees
+ * Stream makes the breadth algorithms write the result level by level while computing
+ */
+template<typename T>
+void ComputeSkycube(	const T* Donnees,
+						const std::vector<bool>& FindLowest,
+						const std::vector<bool>& Orientation,
+						long NombrePoints,
+						long NombreDimensions,
+						ALGO SelectedAlgo,
+						bool ComputeLastNode,
+						bool RowMajor,
+						SKYLINE_ALGO AlgoSkyline,
+						unsigned NbThreads,
+						bool Stream,
+						std::string FichierResultat,
+						const LabelArena* Labels,
+						const PointGroups* Groupes )
+{
+	ArbreCube<T> bouleau( Donnees, FindLowest, NombrePoints, NombreDimensions);
+	bouleau.SetPointGroups( Groupes);
+	if( RowMajor)
+		bouleau.UseRowMajor();
+	bouleau.SetSkylineAlgo( AlgoSkyline);
+	bouleau.SetNbThreads( NbThreads);
+
+	std::ofstream FluxResultat;
+	std::cout << "Selected algorithm ";
+	switch( SelectedAlgo)
+	{
+		case DEPTH: 	if( ComputeLastNode)
+						{
+							std::cout << "Orion-Clos: Depth with last node first" << std::endl;
+							FichierResultat += ".del.";
+						}
+						else
+						{
+							std::cout << "Depth" << std::endl;
+							FichierResultat += ".dep.";
+						}
+						bouleau.DepthAlgo(ComputeLastNode);
+						std::cout << "Processed nodes: " << bouleau.GetNbProcessedNodes() << std::endl;
+						std::cout << "Closure nodes: " << bouleau.GetNbClos() << "/";
+						std::cout <<  FullSpace( NombreDimensions) << std::endl;
+						std::cout << "Closure table: ";
+						bouleau.HashStat( std::cout);
+						std::cout << std::endl;
+						std::cout << "Skyline points found directly / by BNL: " << bouleau.GetNbSkylineFoundDirectly();
+						std::cout << "/" << bouleau.GetNbSkylineFoundByBNL() << std::endl;
+						break;
+		case BREADTH:	std::cout << "Orion: Breadth" << std::endl;
+						FichierResultat += ".bre.";
+						if( Stream)
+							bouleau.SetResultStream( &OpenResult( Orientation, FichierResultat, FluxResultat), Labels);
+						bouleau.BreadthAlgo(false);
+						break;
+		case BR_DOM:	std::cout << "Orion-Tail: Breadth with domains" << std::endl;
+						FichierResultat += ".brd.";
+						if( Stream)
+							bouleau.SetResultStream( &OpenResult( Orientation, FichierResultat, FluxResultat), Labels);
+						bouleau.BreadthAlgo(true);
+						break;
+	}
+	std::cout << "Dominance tests: " << DominanceKernelName() << std::endl;
+	std::cout << "Type I nodes: " << bouleau.GetNbType1() << "/" <<  FullSpace( NombreDimensions) << std::endl;
+
+	/////////////////////////////////////////////////////////////////////////////////////////
+	// Stat of the day
+
+	std::cout << "Peak memory usage: " << GetMemInfo() << std::endl;
+
+#ifndef BENCH
+	/////////////////////////////////////////////////////////////////////////////////////////
+	// Storing result somewhere, unless it has been written while computing
+
+	if( ! Stream)
+		OutputResult( bouleau, Orientation, SelectedAlgo, FichierResultat, Labels);
+
+#endif // BENCH
+}
+
+
+/*
+ * Collapses the identical rows of Donnees, in place if Possede is Donnees itself,
+ * otherwise into a newly allocated matrix
+ * Returns the matrix to use, NombrePoints being updated, and null in Groupes if
+ * there is nothing to collapse
+ */
+template<typename T>
+const T* Deduplicate(	const T* Donnees,
+						T* Possede,
+						long& NombrePoints,
+						long NombreDimensions,
+						PointGroups& Groupes,
+						const PointGroups*& GroupesUtilises )
+{
+	std::cout << "Collapsing identical elements... ";
+	timespec TempusFugit = Utils::GetTime();
+
+	long NbDistincts = FindDuplicateRows( Donnees, NombrePoints, NombreDimensions, Groupes);
+	GroupesUtilises = 0;
+	if( NbDistincts != NombrePoints)
+	{
+		T* Destination = Possede ? Possede : new T[NbDistincts * NombreDimensions];
+		CompactRows( Donnees, Destination, NombrePoints, NombreDimensions, Groupes);
+		Donnees = Destination;
+		GroupesUtilises = &Groupes;
 	}
+
+	Utils::DisplayTime( Utils::GetDiffTime( TempusFugit, Utils::GetTime()), std::cout);
+	std::cout << std::endl << NbDistincts << " distinct points out of " << NombrePoints << " elements" << std::endl;
+	NombrePoints = NbDistincts;
+
+	return Donnees;
+}
+
+
+/*
+ * Drops the points that can't be part of any skyline, see Deduplicate for the parameters
+ */
+template<typename T>
+const T* ReduceToExtendedSkyline(	const T* Donnees,
+									T* Possede,
+									long& NombrePoints,
+									long NombreDimensions,
+									const std::vector<bool>& FindLowest,
+									PointGroups& Groupes,
+									const PointGroups*& GroupesUtilises )
+{
+	std::cout << "Computing the extended skyline... ";
+	timespec TempusFugit = Utils::GetTime();
+
+	long NbRetenus = FindExtendedSkyline( Donnees, NombrePoints, NombreDimensions, FindLowest, Groupes);
+	GroupesUtilises = 0;
+	if( NbRetenus != NombrePoints)
+	{
+		T* Destination = Possede ? Possede : new T[NbRetenus * NombreDimensions];
+		CompactRows( Donnees, Destination, NombrePoints, NombreDimensions, Groupes);
+		Donnees = Destination;
+		GroupesUtilises = &Groupes;
+	}
+
+	Utils::DisplayTime( Utils::GetDiffTime( TempusFugit, Utils::GetTime()), std::cout);
+	std::cout << std::endl << NbRetenus << " points kept out of " << NombrePoints << " elements" << std::endl;
+	NombrePoints = NbRetenus;
+
+	return Donnees;
+}
+
+
+/*
+ * Applies -extsky then -dedup to Donnees, Groupes giving the elements behind each point left
+ * Same contract as Deduplicate: whenever GroupesUtilises is set, the returned matrix is either
+ * Possede or newly allocated
+ */
+template<typename T>
+const T* ReducePoints(	const T* Donnees,
+						T* Possede,
+						long& NombrePoints,
+						long NombreDimensions,
+						const std::vector<bool>& FindLowest,
+						bool ExtSky,
+						bool Dedup,
+						PointGroups& Groupes,
+						const PointGroups*& GroupesUtilises )
+{
+	GroupesUtilises = 0;
+	if( ExtSky)
+		Donnees = ReduceToExtendedSkyline( Donnees, Possede, NombrePoints, NombreDimensions, FindLowest, Groupes, GroupesUtilises);
+
+	if( Dedup)
+	{
+		// once copied out of a read-only matrix, the points are deduplicated in place
+		PointGroups Doublons;
+		const PointGroups* DoublonsUtilises = 0;
+		Donnees = Deduplicate( Donnees, GroupesUtilises ? const_cast<T*>(Donnees) : Possede, NombrePoints, NombreDimensions, Doublons, DoublonsUtilises);
+		if( DoublonsUtilises)
+		{
+			if( GroupesUtilises)
+				Doublons.ExpandThrough( Groupes);
+			Groupes.Swap( Doublons);
+			GroupesUtilises = &Groupes;
+		}
+	}
+
+	return Donnees;
+}
+
+
+/*
+ * Computes the skycube of a new[] allocated matrix, reduced in place if asked, and frees it
+ */
+template<typename T>
+void ComputeOwnedSkycube(	T* Donnees,
+							const std::vector<bool>& FindLowest,
+							const std::vector<bool>& Orientation,
+							long NombrePoints,
+							long NombreDimensions,
+							ALGO SelectedAlgo,
+							bool ComputeLastNode,
+							bool RowMajor,
+							SKYLINE_ALGO AlgoSkyline,
+							unsigned NbThreads,
+							bool Stream,
+							bool ExtSky,
+							bool Dedup,
+							const std::string& FichierResultat,
+							const LabelArena* Labels )
+{
+	PointGroups Groupes;
+	const PointGroups* GroupesUtilises = 0;
+	ReducePoints<T>( Donnees, Donnees, NombrePoints, NombreDimensions, FindLowest, ExtSky, Dedup, Groupes, GroupesUtilises);
+
+	ComputeSkycube( Donnees, FindLowest, Orientation, NombrePoints, NombreDimensions, SelectedAlgo, ComputeLastNode, RowMajor, AlgoSkyline, NbThreads, Stream, FichierResultat, Labels, GroupesUtilises);
+	delete[] Donnees;
+}
+
+
+/*
+ * Converts the matrix to the chosen storage type and tells how many ties it added
+ */
+template<typename T>
+T* Narrow(	const double* Donnees,
+			long NombrePoints,
+			long NombreDimensions,
+			double Echelle,
+			unsigned NbThreads )
+{
+	std::cout << "Converting the data set... ";
+	timespec TempusFugit = Utils::GetTime();
+
+	std::vector<long> Fusions;
+	T* Resultat = NarrowMatrix<T>( Donnees, NombrePoints, NombreDimensions, Echelle, Fusions, NbThreads);
+
+	Utils::DisplayTime( Utils::GetDiffTime( TempusFugit, Utils::GetTime()), std::cout);
+	std::cout << std::endl;
+
+	if( Resultat == 0)
+	{
+		std::cout << "Some values don't fit in the chosen storage" << std::endl;
+		return 0;
+	}
+
+	bool TiesKept = true;
+	for( long i = 0; i < NombreDimensions; i++)
+		if( Fusions[i] > 0)
+		{
+			std::cout << "Warning: " << Fusions[i] << " distinct values merged on dimension " << i << std::endl;
+			TiesKept = false;
+		}
+	if( TiesKept)
+		std::cout << "No distinct values merged, the result is the same as in double precision" << std::endl;
 	else
+		std::cout << "The result may differ from the one in double precision" << std::endl;
+
+	return Resultat;
+}
+
+
+/*
+ * Reads a comma-separated list of columns or ranges of columns (first-last)
+ */
+bool ParseColumnList( const char* Liste, std::vector<long>& Colonnes)
+{
+	const char* p = Liste;
+	for(;;)
 	{
-		std::cout << "Saving result into file " << FichierResultat << std::endl;
+		char* Fin;
+		long Premiere = strtol( p, &Fin, 10);
+		if( Fin == p || Premiere < 0)
+			return false;
+		long Derniere = Premiere;
+		if( *Fin == '-')
+		{
+			p = Fin + 1;
+			Derniere = strtol( p, &Fin, 10);
+			if( Fin == p || Derniere < Premiere)
+				return false;
+		}
 
-		if( SelectedAlgo == DEPTH)
-			bouleau.AfficheClos( OutputStream, Labels);
-		else
-			bouleau.AfficheResultat( OutputStream, Labels);
+		for( long i = Premiere; i <= Derniere; i++)
+			Colonnes.push_back( i);
+
+		if( *Fin == '\0')
+			return true;
+		if( *Fin != ',')
+			return false;
+		p = Fin + 1;
 	}
 }
 
+/*
+ * Reads a COL:MIN:MAX range, a missing bound meaning no limit on that side
+ */
+bool ParseRange( const char* Texte, LoadFilter::Intervalle& Intervalle)
+{
+	char* Fin;
+	Intervalle.Colonne = strtol( Texte, &Fin, 10);
+	if( Fin == Texte || Intervalle.Colonne < 0 || *Fin != ':')
+		return false;
+
+	const char* p = Fin + 1;
+	Intervalle.Min = -std::numeric_limits<double>::max();
+	if( *p != ':')
+	{
+		Intervalle.Min = strtod( p, &Fin);
+		if( Fin == p || *Fin != ':')
+			return false;
+	}
+	else
+		Fin = const_cast<char*>(p);
+
+	p = Fin + 1;
+	Intervalle.Max = std::numeric_limits<double>::max();
+	if( *p != '\0')
+	{
+		Intervalle.Max = strtod( p, &Fin);
+		if( Fin == p || *Fin != '\0')
+			return false;
+	}
+
+	return Intervalle.Min <= Intervalle.Max;
+}
+
 
 int main(int argc, char **argv)
 {
@@ -92,6 +475,17 @@ int main(int argc, char **argv)
 	ALGO SelectedAlgo = DEPTH;
 	bool ComputeLastNode = true;
 	bool HasLabels = false;
+	unsigned NbThreads = 1;
+	const char* FichierBinaire = 0;
+	bool RankTransformed = false;
+	bool Dedup = false;
+	bool ExtSky = false;
+	bool RowMajor = false;
+	bool Stream = false;
+	SKYLINE_ALGO AlgoSkyline = SKY_BNL;
+	STORAGE Stockage = STORE_DOUBLE;
+	double Echelle = 1;
+	LoadFilter Filtre;
 
 	long NumArg = 0;
 	while( ++NumArg < argc - 1)
@@ -143,6 +537,104 @@ int main(int argc, char **argv)
 		{
 			HasLabels = true;
 		}
+		else if( strcmp( argv[NumArg], "-j") == 0)
+		{
+			if( ++NumArg == argc - 1 || atoi( argv[NumArg]) < 1)
+			{
+				std::cout << SYNTAX << std::endl;
+				return 1;
+			}
+
+			NbThreads = atoi( argv[NumArg]);
+		}
+		else if( strcmp( argv[NumArg], "-rank") == 0)
+		{
+			RankTransformed = true;
+		}
+		else if( strcmp( argv[NumArg], "-store") == 0)
+		{
+			if( ++NumArg == argc - 1)
+			{
+				std::cout << SYNTAX << std::endl;
+				return 1;
+			}
+
+			if( strcmp( argv[NumArg], "double") == 0)
+				Stockage = STORE_DOUBLE;
+			else if( strcmp( argv[NumArg], "float") == 0)
+				Stockage = STORE_FLOAT;
+			else if( strncmp( argv[NumArg], "fixed:", 6) == 0 && (Echelle = atof( argv[NumArg] + 6)) > 0)
+				Stockage = STORE_FIXED;
+			else
+			{
+				std::cout << SYNTAX << std::endl;
+				return 1;
+			}
+		}
+		else if( strcmp( argv[NumArg], "-rowmajor") == 0)
+		{
+			RowMajor = true;
+		}
+		else if( strcmp( argv[NumArg], "-sky") == 0)
+		{
+			if( ++NumArg == argc - 1)
+			{
+				std::cout << SYNTAX << std::endl;
+				return 1;
+			}
+
+			if( strcmp( argv[NumArg], "bnl") == 0)
+				AlgoSkyline = SKY_BNL;
+			else if( strcmp( argv[NumArg], "sfs") == 0)
+				AlgoSkyline = SKY_SFS;
+			else if( strcmp( argv[NumArg], "bskytree") == 0)
+				AlgoSkyline = SKY_BSKYTREE;
+			else
+			{
+				std::cout << SYNTAX << std::endl;
+				return 1;
+			}
+		}
+		else if( strcmp( argv[NumArg], "-dedup") == 0)
+		{
+			Dedup = true;
+		}
+		else if( strcmp( argv[NumArg], "-extsky") == 0)
+		{
+			ExtSky = true;
+		}
+		else if( strcmp( argv[NumArg], "-stream") == 0)
+		{
+			Stream = true;
+		}
+		else if( strcmp( argv[NumArg], "-cols") == 0)
+		{
+			if( ++NumArg == argc - 1 || ! ParseColumnList( argv[NumArg], Filtre.Colonnes))
+			{
+				std::cout << SYNTAX << std::endl;
+				return 1;
+			}
+		}
+		else if( strcmp( argv[NumArg], "-where") == 0)
+		{
+			LoadFilter::Intervalle Intervalle;
+			if( ++NumArg == argc - 1 || ! ParseRange( argv[NumArg], Intervalle))
+			{
+				std::cout << SYNTAX << std::endl;
+				return 1;
+			}
+			Filtre.Intervalles.push_back( Intervalle);
+		}
+		else if( strcmp( argv[NumArg], "-convert") == 0)
+		{
+			if( ++NumArg == argc - 1)
+			{
+				std::cout << SYNTAX << std::endl;
+				return 1;
+			}
+
+			FichierBinaire = argv[NumArg];
+		}
 		else
 		{
 			std::cout << SYNTAX << std::endl;
@@ -156,71 +648,133 @@ int main(int argc, char **argv)
 		return 1;
 	}
 
-	double* matrice = 0;
+	double* matrice = 0;				// owned, only when parsing text
+	const double* Donnees = 0;			// the matrix used by ArbreCube, possibly mapped
+	MappedFile FichierMappe;
 	long NombrePoints = 0;
 	long NombreDimensions = 0;
-	std::vector<std::string>* Labels = 0;
+	LabelArena* Labels = 0;
 	if( HasLabels)
-		Labels = new std::vector<std::string>;
+		Labels = new LabelArena;
 
-	if( ! ParseFileIntoMatrix( argv[NumArg], FindLowest.size(), matrice, NombrePoints, NombreDimensions, Labels))
+	if( IsBinaryDataset( argv[NumArg]))
 	{
-		std::cout << "Error in data set parsing" << std::endl;
-		return 1;
+		if( FichierBinaire)
+		{
+			std::cout << argv[NumArg] << " is already a binary data set" << std::endl;
+			return 1;
+		}
+		if( ! Filtre.Colonnes.empty() || ! Filtre.Intervalles.empty())
+		{
+			std::cout << "-cols and -where only apply to text data sets" << std::endl;
+			return 1;
+		}
+
+		if( ! MapBinaryDataset( argv[NumArg], FichierMappe, Donnees, NombrePoints, NombreDimensions, FindLowest, Labels))
+		{
+			std::cout << "Error in binary data set loading" << std::endl;
+			return 1;
+		}
+	}
+	else
+	{
+		if( ! ParseFileIntoMatrix( argv[NumArg], FindLowest.size(), matrice, NombrePoints, NombreDimensions, Labels, NbThreads, &Filtre))
+		{
+			std::cout << "Error in data set parsing" << std::endl;
+			return 1;
+		}
+		Donnees = matrice;
+
+		if( FichierBinaire)
+		{
+			bool Ok = WriteBinaryDataset( FichierBinaire, matrice, NombrePoints, NombreDimensions, FindLowest, Labels);
+			delete[] matrice;
+			return Ok ? 0 : 1;
+		}
 	}
 
 	if( FindLowest.size() == 0)
 		for( int j = 0; j < NombreDimensions; j++)
 			FindLowest.push_back(true);
 
-	ArbreCube bouleau( matrice, FindLowest, NombrePoints, NombreDimensions);
+	if( NombreDimensions > MAX_DIMENSIONS)
+	{
+		std::cout << "At most " << MAX_DIMENSIONS << " dimensions are supported" << std::endl;
+		delete[] matrice;
+		return 1;
+	}
+
+	if( NombrePoints == 0)
+	{
+		std::cout << "No element to compute the skyline of" << (Filtre.Intervalles.empty() ? "" : ", -where rejected every line") << std::endl;
+		delete[] matrice;
+		return 1;
+	}
 
 	// we start creating the result filename here to use the switch once
-	std::string FichierResultat( argv[NumArg]);
+	std::string FichierResultat( strcmp( argv[NumArg], "-") == 0 ? "stdin" : argv[NumArg]);
 
-	std::cout << "Selected algorithm ";
-	switch( SelectedAlgo)
+	if( RankTransformed && Stockage != STORE_DOUBLE)
 	{
-		case DEPTH: 	if( ComputeLastNode)
-						{
-							std::cout << "Orion-Clos: Depth with last node first" << std::endl;
-							FichierResultat += ".del.";
-						}
-						else
-						{
-							std::cout << "Depth" << std::endl;
-							FichierResultat += ".dep.";
-						}
-						bouleau.DepthAlgo(ComputeLastNode);
-						std::cout << "Processed nodes: " << bouleau.GetNbProcessedNodes() << std::endl;
-						std::cout << "Closure nodes: " << bouleau.GetNbClos() << "/";
-						std::cout <<  (1 << NombreDimensions) - 1 << std::endl;
-						std::cout << "Skyline points found directly / by BNL: " << bouleau.GetNbSkylineFoundDirectly();
-						std::cout << "/" << bouleau.GetNbSkylineFoundByBNL() << std::endl;
-						break;
-		case BREADTH:	std::cout << "Orion: Breadth" << std::endl;
-						bouleau.BreadthAlgo(false);
-						FichierResultat += ".bre.";
-						break;
-		case BR_DOM:	std::cout << "Orion-Tail: Breadth with domains" << std::endl;
-						bouleau.BreadthAlgo(true);
-						FichierResultat += ".brd.";
-						break;
+		std::cout << "-rank and -store can't be used together" << std::endl;
+		return 1;
 	}
-	std::cout << "Type I nodes: " << bouleau.GetNbType1() << "/" <<  (1 << NombreDimensions) - 1 << std::endl;
 
-	/////////////////////////////////////////////////////////////////////////////////////////
-	// Stat of the day
+	if( Stream && SelectedAlgo == DEPTH)
+	{
+		std::cout << "-stream only applies to breadth and br_dom" << std::endl;
+		return 1;
+	}
 
-	std::cout << "Peak memory usage: " << GetMemInfo() << std::endl;
+	uint32_t* Rangs = 0;
+	float* Flottants = 0;
+	int32_t* Entiers = 0;
+	if( RankTransformed)
+	{
+		std::cout << "Rank-transforming the data set... ";
+		timespec TempusFugit = Utils::GetTime();
 
-#ifndef BENCH
-	/////////////////////////////////////////////////////////////////////////////////////////
-	// Storing result somewhere
+		Rangs = RankTransform( Donnees, NombrePoints, NombreDimensions, FindLowest, NbThreads);
 
-	OutputResult( bouleau, FindLowest, SelectedAlgo, FichierResultat, Labels);
+		Utils::DisplayTime( Utils::GetDiffTime( TempusFugit, Utils::GetTime()), std::cout);
+		std::cout << std::endl;
+	}
+	else if( Stockage == STORE_FLOAT && (Flottants = Narrow<float>( Donnees, NombrePoints, NombreDimensions, Echelle, NbThreads)) == 0)
+		return 1;
+	else if( Stockage == STORE_FIXED && (Entiers = Narrow<int32_t>( Donnees, NombrePoints, NombreDimensions, Echelle, NbThreads)) == 0)
+		return 1;
 
-#endif // BENCH
+	if( Rangs || Flottants || Entiers)
+	{
+		delete[] matrice;
+		matrice = 0;
+		// the labels of a binary data set are still read from the mapping
+		if( Labels == 0)
+			FichierMappe.Close();
+	}
+
+	if( Rangs)
+	{
+		// ranks are oriented, lower is always better
+		std::vector<bool> AllLowest( NombreDimensions, true);
+		ComputeOwnedSkycube( Rangs, AllLowest, FindLowest, NombrePoints, NombreDimensions, SelectedAlgo, ComputeLastNode, RowMajor, AlgoSkyline, NbThreads, Stream, ExtSky, Dedup, FichierResultat, Labels);
+	}
+	else if( Flottants)
+		ComputeOwnedSkycube( Flottants, FindLowest, FindLowest, NombrePoints, NombreDimensions, SelectedAlgo, ComputeLastNode, RowMajor, AlgoSkyline, NbThreads, Stream, ExtSky, Dedup, FichierResultat, Labels);
+	else if( Entiers)
+		ComputeOwnedSkycube( Entiers, FindLowest, FindLowest, NombrePoints, NombreDimensions, SelectedAlgo, ComputeLastNode, RowMajor, AlgoSkyline, NbThreads, Stream, ExtSky, Dedup, FichierResultat, Labels);
+	else
+	{
+		PointGroups Groupes;
+		const PointGroups* GroupesUtilises = 0;
+
+		// a mapped matrix is read-only, the remaining points are copied out of it
+		Donnees = ReducePoints( Donnees, matrice, NombrePoints, NombreDimensions, FindLowest, ExtSky, Dedup, Groupes, GroupesUtilises);
+		if( matrice == 0 && GroupesUtilises)
+			matrice = const_cast<double*>(Donnees);
+
+		ComputeSkycube( Donnees, FindLowest, FindLowest, NombrePoints, NombreDimensions, SelectedAlgo, ComputeLastNode, RowMajor, AlgoSkyline, NbThreads, Stream, FichierResultat, Labels, GroupesUtilises);
+	}
 
 	delete[] matrice;
 
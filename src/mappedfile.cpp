@@ -0,0 +1,122 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mappedfile.h"
+
+
+MappedFile::MappedFile() :
+	Debut( 0),
+	Taille( 0),
+	EstMappe( false),
+	Tampon( 0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open( const char* FileName, bool Sequential)
+{
+	Close();
+
+	bool IsStdin = strcmp( FileName, "-") == 0;
+	int fd = IsStdin ? STDIN_FILENO : open( FileName, O_RDONLY);
+	if( fd < 0)
+		return false;
+
+	struct stat Infos;
+	if( fstat( fd, &Infos) == 0 && S_ISREG( Infos.st_mode) && Infos.st_size > 0)
+	{
+		void* Adresse = mmap( 0, Infos.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if( Adresse != MAP_FAILED)
+		{
+			if( Sequential)
+				madvise( Adresse, Infos.st_size, MADV_SEQUENTIAL);
+			Debut = static_cast<const char*>(Adresse);
+			Taille = Infos.st_size;
+			EstMappe = true;
+			if( ! IsStdin)
+				close( fd);
+			return true;
+		}
+	}
+
+	// not mappable (pipe, terminal, empty file...), read it the hard way
+	bool Ok = ReadAll( fd);
+	if( ! IsStdin)
+		close( fd);
+	return Ok;
+}
+
+void MappedFile::Close()
+{
+	if( EstMappe)
+		munmap( const_cast<char*>(Debut), Taille);
+	free( Tampon);
+
+	Debut = 0;
+	Taille = 0;
+	EstMappe = false;
+	Tampon = 0;
+}
+
+bool MappedFile::ReadAll( int fd)
+{
+	size_t Capacite = 1 << 20;
+	Tampon = static_cast<char*>(malloc( Capacite));
+	if( Tampon == 0)
+		return false;
+
+	for(;;)
+	{
+		if( Taille == Capacite)
+		{
+			char* Nouveau = static_cast<char*>(realloc( Tampon, Capacite * 2));
+			if( Nouveau == 0)
+				return false;
+			Tampon = Nouveau;
+			Capacite *= 2;
+		}
+
+		ssize_t Lus = read( fd, Tampon + Taille, Capacite - Taille);
+		if( Lus == 0)
+			break;
+		if( Lus < 0)
+		{
+			if( errno == EINTR)
+				continue;
+			return false;
+		}
+		Taille += Lus;
+	}
+
+	Debut = Tampon;
+	return true;
+}
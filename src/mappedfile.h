@@ -0,0 +1,64 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+
+#include <cstddef>
+
+
+/*
+ * Read-only view of a whole input file
+ * Regular files are mapped in memory, anything else (standard input, pipes...)
+ * is read into a growable buffer
+ */
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	/*
+	 * Opens FileName, "-" standing for the standard input
+	 * Sequential tells the kernel the mapping will be read once from start to end
+	 * Returns false if the file can't be opened or read
+	 */
+	bool Open( const char* FileName, bool Sequential = true);
+	void Close();
+
+	const char* Data() const		{ return Debut; }
+	size_t Size() const				{ return Taille; }
+	bool IsMapped() const			{ return EstMappe; }
+
+private:
+	MappedFile( const MappedFile&);
+	MappedFile& operator=( const MappedFile&);
+
+	bool ReadAll( int fd);
+
+	const char* Debut;
+	size_t Taille;
+	bool EstMappe;
+	char* Tampon;			// only used when the file couldn't be mapped
+};
+
+
+#endif // MAPPEDFILE_H_
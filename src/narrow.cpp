@@ -0,0 +1,168 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+#include "narrow.h"
+#include "utils.h"
+
+
+namespace {
+
+template<typename T>
+struct Narrowing;
+
+template<>
+struct Narrowing<float>
+{
+	static bool Convert( double Valeur, double, float& Resultat)
+	{
+		if( Valeur >= FLT_MAX)
+			Resultat = FLT_MAX;
+		else if( Valeur <= -FLT_MAX)
+			Resultat = -FLT_MAX;
+		else
+			Resultat = static_cast<float>(Valeur);
+		return true;
+	}
+};
+
+template<>
+struct Narrowing<int32_t>
+{
+	static bool Convert( double Valeur, double Echelle, int32_t& Resultat)
+	{
+		// the largest integer is kept for "inf"
+		if( Valeur == DBL_MAX)
+		{
+			Resultat = std::numeric_limits<int32_t>::max();
+			return true;
+		}
+
+		double Arrondi = floor( Valeur * Echelle + 0.5);
+		if( Arrondi < std::numeric_limits<int32_t>::min() || Arrondi >= std::numeric_limits<int32_t>::max())
+			return false;
+		Resultat = static_cast<int32_t>(Arrondi);
+		return true;
+	}
+};
+
+template<typename T>
+class NarrowTask : public ParallelTask
+{
+public:
+	NarrowTask(	const double* p_matrice,
+				T* p_Resultat,
+				long p_NombrePoints,
+				long p_NombreDimensions,
+				double p_Echelle,
+				std::vector<long>& p_Fusions,
+				unsigned p_NbThreads) :
+		matrice( p_matrice),
+		Resultat( p_Resultat),
+		NombrePoints( p_NombrePoints),
+		NombreDimensions( p_NombreDimensions),
+		Echelle( p_Echelle),
+		Fusions( p_Fusions),
+		NbThreads( p_NbThreads)
+	{
+	}
+
+	void Run( unsigned NumThread)
+	{
+		std::vector<double> Tri( NombrePoints);
+
+		for( long i = NumThread; i < NombreDimensions; i += NbThreads)
+		{
+			const double* Colonne = matrice + i * NombrePoints;
+			T* ColonneResultat = Resultat + i * NombrePoints;
+
+			for( long j = 0; j < NombrePoints; j++)
+				if( ! Narrowing<T>::Convert( Colonne[j], Echelle, ColonneResultat[j]))
+				{
+					Fusions[i] = -1;
+					break;
+				}
+			if( Fusions[i] < 0 || NombrePoints == 0)
+				continue;
+
+			// the conversion is monotonic, ties can only be added between neighbours
+			std::copy( Colonne, Colonne + NombrePoints, Tri.begin());
+			std::sort( Tri.begin(), Tri.end());
+
+			T Precedent = T();
+			Narrowing<T>::Convert( Tri[0], Echelle, Precedent);
+			for( long j = 1; j < NombrePoints; j++)
+			{
+				T Courant = T();
+				Narrowing<T>::Convert( Tri[j], Echelle, Courant);
+				if( Tri[j-1] < Tri[j] && ! (Precedent < Courant))
+					Fusions[i]++;
+				Precedent = Courant;
+			}
+		}
+	}
+
+private:
+	const double* const matrice;
+	T* const Resultat;
+	const long NombrePoints;
+	const long NombreDimensions;
+	const double Echelle;
+	std::vector<long>& Fusions;
+	const unsigned NbThreads;
+};
+
+}
+
+
+template<typename T>
+T* NarrowMatrix(	const double* matrice,
+					long NombrePoints,
+					long NombreDimensions,
+					double Echelle,
+					std::vector<long>& Fusions,
+					unsigned NbThreads )
+{
+	T* Resultat = new T[NombrePoints*NombreDimensions];
+	Fusions.assign( NombreDimensions, 0);
+
+	if( NbThreads > static_cast<unsigned long>(NombreDimensions))
+		NbThreads = NombreDimensions;
+
+	NarrowTask<T> Conversion( matrice, Resultat, NombrePoints, NombreDimensions, Echelle, Fusions, NbThreads);
+	Utils::RunParallel( Conversion, NbThreads);
+
+	if( std::find( Fusions.begin(), Fusions.end(), -1) != Fusions.end())
+	{
+		delete[] Resultat;
+		return 0;
+	}
+
+	return Resultat;
+}
+
+
+template float* NarrowMatrix<float>( const double*, long, long, double, std::vector<long>&, unsigned);
+template int32_t* NarrowMatrix<int32_t>( const double*, long, long, double, std::vector<long>&, unsigned);
@@ -0,0 +1,46 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#ifndef NARROW_H_
+#define NARROW_H_
+
+
+#include <stdint.h>
+#include <vector>
+
+
+/*
+ * Converts the column-major matrice into a new[] allocated matrix of floats, or of int32_t
+ * holding the values multiplied by Echelle and rounded to the nearest integer
+ * Both conversions keep the order of the values but may merge close ones, Fusions receiving
+ * for each dimension the number of distinct values lost
+ * Returns null if a value doesn't fit in T (the "inf" value becomes the largest T)
+ */
+template<typename T>
+T* NarrowMatrix(	const double* matrice,
+					long NombrePoints,
+					long NombreDimensions,
+					double Echelle,
+					std::vector<long>& Fusions,
+					unsigned NbThreads = 1 );
+
+
+#endif // NARROW_H_
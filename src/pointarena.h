@@ -0,0 +1,151 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#ifndef POINTARENA_H_
+#define POINTARENA_H_
+
+
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "defs.h"
+
+
+/*
+ * Point numbers allocated in large blocks and freed all at once, for data that lives as long as
+ * the arena or until it is cleared (the skylines of the lattice nodes and of the closures)
+ */
+class PointArena
+{
+public:
+	PointArena() : Libre( 0), Restant( 0) {}
+	~PointArena()							{ Clear(); }
+
+	PointId* Allocate( size_t Taille)
+	{
+		if( Taille > Restant)
+		{
+			Restant = std::max<size_t>( Taille, TAILLE_BLOC);
+			Blocs.push_back( new PointId[Restant]);
+			Libre = Blocs.back();
+		}
+		PointId* Debut = Libre;
+		Libre += Taille;
+		Restant -= Taille;
+		return Debut;
+	}
+
+	// frees every block, whatever was allocated must not be read anymore
+	void Clear()
+	{
+		for( size_t b = 0; b < Blocs.size(); b++)
+			delete[] Blocs[b];
+		Blocs.clear();
+		Libre = 0;
+		Restant = 0;
+	}
+
+private:
+	PointArena( const PointArena&);
+	PointArena& operator=( const PointArena&);
+
+	enum { TAILLE_BLOC = 1 << 16 };
+
+	std::vector<PointId*> Blocs;
+	PointId* Libre;						// end of the used part of the last block
+	size_t Restant;
+};
+
+
+// read-only view of consecutive sorted point numbers, usable where a CompactSet is read
+struct PointRange
+{
+	typedef PointId value_type;
+	typedef const PointId* const_iterator;
+
+	PointRange() : Debut( 0), Fin( 0) {}
+	PointRange( const PointId* Debut_p, const PointId* Fin_p) : Debut( Debut_p), Fin( Fin_p) {}
+
+	const_iterator begin() const			{ return Debut; }
+	const_iterator end() const				{ return Fin; }
+	size_t size() const						{ return Fin - Debut; }
+	bool empty() const						{ return Debut == Fin; }
+
+	const PointId* Debut;
+	const PointId* Fin;
+};
+
+
+/*
+ * Read-only view of groups of combined points stored one after the other, each of them as its
+ * size followed by its points, usable where a CompactComb is read
+ */
+class GroupList
+{
+public:
+	class const_iterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef PointRange value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const PointRange* pointer;
+		typedef const PointRange& reference;
+
+		const_iterator() : Position( 0) {}
+		explicit const_iterator( const PointId* Position_p) : Position( Position_p) {}
+
+		const PointRange& operator*() const		{ Courant = PointRange( Position + 1, Position + 1 + *Position); return Courant; }
+		const PointRange* operator->() const	{ return &**this; }
+		const_iterator& operator++()			{ Position += 1 + *Position; return *this; }
+		const_iterator operator++( int)			{ const_iterator Avant( *this); ++*this; return Avant; }
+		bool operator==( const const_iterator& Autre) const		{ return Position == Autre.Position; }
+		bool operator!=( const const_iterator& Autre) const		{ return Position != Autre.Position; }
+
+	private:
+		const PointId* Position;
+		mutable PointRange Courant;
+	};
+
+	typedef PointRange value_type;
+
+	GroupList( const PointId* Debut_p, const PointId* Fin_p, size_t NbGroupes_p) :
+		Debut( Debut_p),
+		Fin( Fin_p),
+		NbGroupes( NbGroupes_p)
+	{
+	}
+
+	const_iterator begin() const			{ return const_iterator( Debut); }
+	const_iterator end() const				{ return const_iterator( Fin); }
+	size_t size() const						{ return NbGroupes; }
+	bool empty() const						{ return NbGroupes == 0; }
+
+private:
+	const PointId* Debut;
+	const PointId* Fin;
+	size_t NbGroupes;
+};
+
+
+#endif // POINTARENA_H_
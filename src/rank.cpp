@@ -0,0 +1,114 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include <algorithm>
+
+#include "rank.h"
+#include "utils.h"
+
+
+namespace {
+
+struct ltvalue
+{
+	ltvalue( const double* p_Colonne) : Colonne( p_Colonne) {}
+
+	bool operator()( long P1, long P2) const
+	{
+		return Colonne[P1] < Colonne[P2];
+	}
+
+	const double* Colonne;
+};
+
+class RankTask : public ParallelTask
+{
+public:
+	RankTask(	const double* p_matrice,
+				uint32_t* p_Rangs,
+				long p_NombrePoints,
+				long p_NombreDimensions,
+				const std::vector<bool>& p_FindLowest,
+				unsigned p_NbThreads) :
+		matrice( p_matrice),
+		Rangs( p_Rangs),
+		NombrePoints( p_NombrePoints),
+		NombreDimensions( p_NombreDimensions),
+		FindLowest( p_FindLowest),
+		NbThreads( p_NbThreads)
+	{
+	}
+
+	void Run( unsigned NumThread)
+	{
+		std::vector<long> Ordre( NombrePoints);
+
+		for( long i = NumThread; i < NombreDimensions; i += NbThreads)
+		{
+			const double* Colonne = matrice + i * NombrePoints;
+			uint32_t* ColonneRangs = Rangs + i * NombrePoints;
+
+			for( long j = 0; j < NombrePoints; j++)
+				Ordre[j] = j;
+			std::sort( Ordre.begin(), Ordre.end(), ltvalue( Colonne));
+
+			uint32_t Rang = 0;
+			for( long j = 0; j < NombrePoints; j++)
+			{
+				if( j > 0 && Colonne[Ordre[j-1]] < Colonne[Ordre[j]])
+					Rang++;
+				ColonneRangs[Ordre[j]] = Rang;
+			}
+
+			// the best value must get the lowest rank
+			if( ! FindLowest[i])
+				for( long j = 0; j < NombrePoints; j++)
+					ColonneRangs[j] = Rang - ColonneRangs[j];
+		}
+	}
+
+private:
+	const double* const matrice;
+	uint32_t* const Rangs;
+	const long NombrePoints;
+	const long NombreDimensions;
+	const std::vector<bool>& FindLowest;
+	const unsigned NbThreads;
+};
+
+}
+
+
+uint32_t* RankTransform(	const double* matrice,
+							long NombrePoints,
+							long NombreDimensions,
+							const std::vector<bool>& FindLowest,
+							unsigned NbThreads )
+{
+	uint32_t* Rangs = new uint32_t[NombrePoints*NombreDimensions];
+
+	if( NbThreads > static_cast<unsigned long>(NombreDimensions))
+		NbThreads = NombreDimensions;
+
+	RankTask Classement( matrice, Rangs, NombrePoints, NombreDimensions, FindLowest, NbThreads);
+	Utils::RunParallel( Classement, NbThreads);
+
+	return Rangs;
+}
@@ -0,0 +1,42 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef RANK_H_
+#define RANK_H_
+
+
+#include <stdint.h>
+#include <vector>
+
+
+/*
+ * Replaces every column of matrice by the dense rank of its values, equal values sharing
+ * the same rank so that combined points stay combined
+ * Dimensions where upper is better are flipped: a lower rank is always better afterwards
+ * Returns a new[] allocated column-major matrix, the columns being ranked by NbThreads threads
+ */
+uint32_t* RankTransform(	const double* matrice,
+							long NombrePoints,
+							long NombreDimensions,
+							const std::vector<bool>& FindLowest,
+							unsigned NbThreads = 1 );
+
+
+#endif // RANK_H_
@@ -18,87 +18,635 @@
  */
 
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+
 #include "readfile.h"
+#include "mappedfile.h"
+#include "utils.h"
+
+
+namespace {
+
+enum LineStatus { LINE_OK, LINE_EMPTY_FIELD, LINE_FIELD_COUNT, LINE_BAD_VALUE };
 
+// powers of ten exactly representable as a double
+const double PuissancesDix[] = {	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+									1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+									1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
 
-long StringTokenCounter( const std::string& Source, char delim)
+/*
+ * Converts the field [Debut, Fin) without any allocation
+ * Short decimal numbers are converted exactly by a single multiplication or division
+ * (mantissa below 2^53 and power of ten below 10^22), anything else goes through strtod
+ * inf, -inf and the values beyond the range of a double are all stored as the largest finite
+ * double of their sign, so that sums of values stay comparable
+ * Returns false if the field isn't a number
+ */
+bool ParseValue( const char* Debut, const char* Fin, double& Valeur)
 {
-	long NombreValeurs = 0;
-	size_t pos1 = 0, pos2 = 0;
+	const char* p = Debut;
+	bool Negatif = false;
+	if( p != Fin && (*p == '-' || *p == '+'))
+		Negatif = (*p++ == '-');
 
-	while( ( pos2 = Source.find_first_of( delim, pos2 + 1)) != std::string::npos)
+	if( Fin - p == 3 && memcmp( p, "inf", 3) == 0)
 	{
-		if( pos1 == pos2)
-			return -pos1;
-		pos1 = pos2 + 1;
-		NombreValeurs++;
+		Valeur = Negatif ? -std::numeric_limits<double>::max() : std::numeric_limits<double>::max();
+		return true;
 	}
 
-	if( ! (pos1 == 0 && pos2 == std::string::npos))
-		NombreValeurs++;
+	uint64_t Mantisse = 0;
+	int NbChiffres = 0;
+	int Exposant = 0;
+	bool AuMoinsUnChiffre = false;
+
+	for( ; p != Fin && *p >= '0' && *p <= '9'; ++p)
+	{
+		AuMoinsUnChiffre = true;
+		if( Mantisse == 0 && *p == '0')
+			continue;
+		if( ++NbChiffres <= 19)
+			Mantisse = Mantisse * 10 + (*p - '0');
+		else
+			Exposant++;
+	}
+	if( p != Fin && *p == '.')
+	{
+		for( ++p; p != Fin && *p >= '0' && *p <= '9'; ++p)
+		{
+			AuMoinsUnChiffre = true;
+			if( Mantisse == 0 && *p == '0')
+			{
+				Exposant--;
+				continue;
+			}
+			if( ++NbChiffres <= 19)
+			{
+				Mantisse = Mantisse * 10 + (*p - '0');
+				Exposant--;
+			}
+		}
+	}
+	if( ! AuMoinsUnChiffre)
+		return false;
+
+	if( p != Fin && (*p == 'e' || *p == 'E'))
+	{
+		++p;
+		bool ExpNegatif = false;
+		if( p != Fin && (*p == '-' || *p == '+'))
+			ExpNegatif = (*p++ == '-');
+		if( p == Fin || *p < '0' || *p > '9')
+			return false;
+		int ExpLu = 0;
+		for( ; p != Fin && *p >= '0' && *p <= '9'; ++p)
+			if( ExpLu < 100000)
+				ExpLu = ExpLu * 10 + (*p - '0');
+		Exposant += ExpNegatif ? -ExpLu : ExpLu;
+	}
+	if( p != Fin)
+		return false;
+
+	if( Mantisse == 0)
+	{
+		Valeur = Negatif ? -0.0 : 0.0;
+		return true;
+	}
+
+	if( NbChiffres <= 19 && Mantisse <= (uint64_t(1) << 53) && Exposant >= -22 && Exposant <= 22)
+	{
+		Valeur = static_cast<double>(Mantisse);
+		if( Exposant < 0)
+			Valeur /= PuissancesDix[-Exposant];
+		else
+			Valeur *= PuissancesDix[Exposant];
+		if( Negatif)
+			Valeur = -Valeur;
+		return true;
+	}
 
-	return NombreValeurs;
+	// the syntax has been checked above, strtod only handles the rounding
+	char Copie[128];
+	if( Fin - Debut >= static_cast<long>(sizeof(Copie)))
+		return false;
+	memcpy( Copie, Debut, Fin - Debut);
+	Copie[Fin - Debut] = '\0';
+	Valeur = strtod( Copie, 0);
+	if( Valeur > std::numeric_limits<double>::max())
+		Valeur = std::numeric_limits<double>::max();
+	else if( Valeur < -std::numeric_limits<double>::max())
+		Valeur = -std::numeric_limits<double>::max();
+	return true;
 }
 
-void StringTokenizer(	std::istringstream& Source,
+/*
+ * What has to be done with each column of the file, built once from the LoadFilter
+ */
+struct FieldPlan
+{
+	long NbColonnes;				// columns of the file, label excluded
+	bool HasLabels;
+	bool AvecFiltre;				// whether some lines may be rejected
+	std::vector<long> Dimension;	// dimension of matrice receiving each column, -1 if skipped
+	std::vector<char> Filtree;		// whether the column has a range
+	std::vector<double> Min;
+	std::vector<double> Max;
+};
+
+/*
+ * Parses the line [Debut, Fin) and stores the selected values in column-major matrice at row NumeroPoint
+ * With a null matrice the line is only checked (empty fields, number of fields, values and ranges),
+ * the values being converted exactly as when they are stored so that errors are found on the same line
+ * Retenue tells whether the values are within the ranges of the plan, Filtrer being false skipping that test
+ * Position receives the offending character in case of error, NbChamps the number of fields found
+ */
+LineStatus ParseLine(	const char* Debut,
+						const char* Fin,
+						char delim,
+						const FieldPlan& Plan,
+						bool Filtrer,
 						double* matrice,
 						const long NumeroPoint,
-						const long NombrePoints,
-						const long NombreDimensions,
+						const long Stride,
+						LabelArena* Labels,
+						bool& Retenue,
+						long& Position,
+						long& NbChamps)
+{
+	const char* p = Debut;
+	const char* DebutLabel = Debut;
+	const char* FinLabel = Debut;
+	long Champ = Plan.HasLabels ? -1 : 0;
+	Retenue = true;
+
+	for(;;)
+	{
+		const char* q = static_cast<const char*>(memchr( p, delim, Fin - p));
+		if( q == 0)
+			q = Fin;
+
+		if( q == p)
+		{
+			Position = p - Debut;
+			return LINE_EMPTY_FIELD;
+		}
+
+		if( Champ < 0)
+		{
+			DebutLabel = p;
+			FinLabel = q;
+		}
+		else if( Champ < Plan.NbColonnes && Retenue)
+		{
+			const long Dim = Plan.Dimension[Champ];
+			const bool Teste = Filtrer && Plan.Filtree[Champ];
+			if( Dim >= 0 || Teste)
+			{
+				double Valeur;
+				if( ! ParseValue( p, q, Valeur))
+				{
+					Position = p - Debut;
+					return LINE_BAD_VALUE;
+				}
+
+				// the rest of a rejected line is only counted
+				if( Teste && (Valeur < Plan.Min[Champ] || Valeur > Plan.Max[Champ]))
+					Retenue = false;
+				else if( Dim >= 0 && matrice)
+					matrice[Dim*Stride + NumeroPoint] = Valeur;
+			}
+		}
+		Champ++;
+
+		if( q == Fin)
+			break;
+		p = q + 1;
+	}
+
+	NbChamps = Champ;
+	if( Champ != Plan.NbColonnes)
+		return LINE_FIELD_COUNT;
+
+	if( Labels && Retenue)
+		Labels->Add( DebutLabel, FinLabel);
+	return LINE_OK;
+}
+
+// returns the end of the line starting at Debut, trailing carriage return excluded
+const char* EndOfLine( const char* Debut, const char* Fin, const char*& Suivant)
+{
+	const char* p = static_cast<const char*>(memchr( Debut, '\n', Fin - Debut));
+	if( p == 0)
+	{
+		Suivant = Fin;
+		p = Fin;
+	}
+	else
+		Suivant = p + 1;
+
+	if( p != Debut && *(p - 1) == '\r')
+		--p;
+	return p;
+}
+
+// upper bound of the number of points, the parser may stop earlier on an empty line
+long CountLines( const char* Debut, const char* Fin)
+{
+	long NbLignes = 0;
+	for( const char* p = Debut; (p = static_cast<const char*>(memchr( p, '\n', Fin - p))) != 0; ++p)
+		NbLignes++;
+
+	if( Debut != Fin && *(Fin - 1) != '\n')
+		NbLignes++;
+	return NbLignes;
+}
+
+void ReportLineError( LineStatus Status, long NumLigne, long Position, long NbChamps, long NombreColonnes)
+{
+	switch( Status)
+	{
+		case LINE_EMPTY_FIELD:	std::cout << "Empty field line " << NumLigne << " character " << Position << std::endl;
+								break;
+		case LINE_BAD_VALUE:	std::cout << "Invalid value line " << NumLigne << " character " << Position << std::endl;
+								break;
+		case LINE_FIELD_COUNT:	std::cout << "Line " << NumLigne << " : " << NbChamps << " dimensions instead of " << NombreColonnes << std::endl;
+								break;
+		case LINE_OK:			break;
+	}
+}
+
+/*
+ * Builds the plan of the NbColonnes columns of the file, NombreDimensions receiving
+ * the number of selected ones
+ */
+bool BuildPlan( const LoadFilter* Filtre, long NbColonnes, bool HasLabels, FieldPlan& Plan, long& NombreDimensions)
+{
+	Plan.NbColonnes = NbColonnes;
+	Plan.HasLabels = HasLabels;
+	Plan.AvecFiltre = false;
+	Plan.Filtree.assign( NbColonnes, 0);
+	Plan.Min.assign( NbColonnes, -std::numeric_limits<double>::max());
+	Plan.Max.assign( NbColonnes, std::numeric_limits<double>::max());
+
+	if( Filtre == 0 || Filtre->Colonnes.empty())
+	{
+		Plan.Dimension.resize( NbColonnes);
+		for( long i = 0; i < NbColonnes; i++)
+			Plan.Dimension[i] = i;
+		NombreDimensions = NbColonnes;
+	}
+	else
+	{
+		Plan.Dimension.assign( NbColonnes, -1);
+		for( size_t i = 0; i < Filtre->Colonnes.size(); i++)
+		{
+			long Colonne = Filtre->Colonnes[i];
+			if( Colonne < 0 || Colonne >= NbColonnes)
+			{
+				std::cout << "Column " << Colonne << " selected but the data set has " << NbColonnes << " columns" << std::endl;
+				return false;
+			}
+			if( Plan.Dimension[Colonne] >= 0)
+			{
+				std::cout << "Column " << Colonne << " selected twice" << std::endl;
+				return false;
+			}
+			Plan.Dimension[Colonne] = i;
+		}
+		NombreDimensions = Filtre->Colonnes.size();
+	}
+
+	if( Filtre)
+		for( std::vector<LoadFilter::Intervalle>::const_iterator iteI = Filtre->Intervalles.begin(); iteI != Filtre->Intervalles.end(); ++iteI)
+		{
+			if( iteI->Colonne < 0 || iteI->Colonne >= NbColonnes)
+			{
+				std::cout << "Range on column " << iteI->Colonne << " but the data set has " << NbColonnes << " columns" << std::endl;
+				return false;
+			}
+
+			// several ranges on the same column are intersected
+			Plan.Filtree[iteI->Colonne] = 1;
+			Plan.Min[iteI->Colonne] = std::max( Plan.Min[iteI->Colonne], iteI->Min);
+			Plan.Max[iteI->Colonne] = std::min( Plan.Max[iteI->Colonne], iteI->Max);
+			Plan.AvecFiltre = true;
+		}
+
+	return true;
+}
+
+
+/*
+ * Part of the file handled by one thread, it always starts at the beginning of a line
+ */
+struct Chunk
+{
+	const char* Debut;
+	const char* Fin;
+
+	long NbLignes;			// lines before the first empty or erroneous one
+	long NbPoints;			// lines kept among them
+	bool Arret;				// whether the chunk stopped early
+	LineStatus Status;		// LINE_OK if it stopped on an empty line
+	long Position;
+	long NbChamps;
+
+	long PremiereLigne;		// lines of the file before the chunk
+	long PremierPoint;		// row of its first kept line in matrice
+	std::vector<bool> Retenues;		// whether each line is kept, only with ranges
+	LabelArena Labels;
+};
+
+/*
+ * First pass: every thread counts and checks the lines of its chunk, and applies the ranges
+ * The selected values are converted and dropped, so that the first error of the file is the
+ * one reported, as when loading with a single thread
+ */
+class CountTask : public ParallelTask
+{
+public:
+	CountTask( std::vector<Chunk>& p_Chunks, char p_delim, const FieldPlan& p_Plan) :
+		Chunks( p_Chunks),
+		delim( p_delim),
+		Plan( p_Plan)
+	{
+	}
+
+	void Run( unsigned NumThread)
+	{
+		Chunk& Morceau = Chunks[NumThread];
+		const char* Suivant;
+		bool Retenue;
+
+		Morceau.NbLignes = 0;
+		Morceau.NbPoints = 0;
+		Morceau.Arret = false;
+		for( const char* Ligne = Morceau.Debut; Ligne != Morceau.Fin; Ligne = Suivant)
+		{
+			const char* FinLigne = EndOfLine( Ligne, Morceau.Fin, Suivant);
+
+			if( Ligne == FinLigne)
+				Morceau.Status = LINE_OK;
+			else
+				Morceau.Status = ParseLine( Ligne, FinLigne, delim, Plan, true, 0, 0, 0, 0, Retenue, Morceau.Position, Morceau.NbChamps);
+
+			if( Ligne == FinLigne || Morceau.Status != LINE_OK)
+			{
+				Morceau.Arret = true;
+				return;
+			}
+			Morceau.NbLignes++;
+			if( Retenue)
+				Morceau.NbPoints++;
+			if( Plan.AvecFiltre)
+				Morceau.Retenues.push_back( Retenue);
+		}
+	}
+
+private:
+	std::vector<Chunk>& Chunks;
+	const char delim;
+	const FieldPlan& Plan;
+};
+
+/*
+ * Second pass: every thread converts its kept lines at their final place in matrice, the first
+ * one having checked them already
+ */
+class ParseTask : public ParallelTask
+{
+public:
+	ParseTask( std::vector<Chunk>& p_Chunks, char p_delim, const FieldPlan& p_Plan, double* p_matrice, long p_NombrePoints) :
+		Chunks( p_Chunks),
+		delim( p_delim),
+		Plan( p_Plan),
+		matrice( p_matrice),
+		NombrePoints( p_NombrePoints)
+	{
+	}
+
+	void Run( unsigned NumThread)
+	{
+		Chunk& Morceau = Chunks[NumThread];
+		const char* Suivant;
+		const char* Ligne = Morceau.Debut;
+		long NumeroPoint = Morceau.PremierPoint;
+		bool Retenue;
+
+		if( Plan.HasLabels)
+			Morceau.Labels.Reserve( Morceau.NbPoints);
+
+		Morceau.Status = LINE_OK;
+		for( long i = 0; i < Morceau.NbLignes; i++, Ligne = Suivant)
+		{
+			const char* FinLigne = EndOfLine( Ligne, Morceau.Fin, Suivant);
+			if( Plan.AvecFiltre && ! Morceau.Retenues[i])
+				continue;
+
+			Morceau.Status = ParseLine(	Ligne, FinLigne, delim, Plan, false, matrice, NumeroPoint++, NombrePoints,
+										Plan.HasLabels ? &Morceau.Labels : 0, Retenue, Morceau.Position, Morceau.NbChamps);
+			if( Morceau.Status != LINE_OK)
+			{
+				Morceau.NbLignes = i;
+				return;
+			}
+		}
+	}
+
+private:
+	std::vector<Chunk>& Chunks;
+	const char delim;
+	const FieldPlan& Plan;
+	double* const matrice;
+	const long NombrePoints;
+};
+
+/*
+ * Single-threaded loading loop, matrice is sized from the number of lines and packed
+ * afterwards if the parser stopped on an empty line or rejected some lines
+ */
+bool ParseSinglePass(	const char* Debut,
+						const char* Fin,
 						char delim,
-						std::vector<std::string>* Labels)
+						const FieldPlan& Plan,
+						double*& matrice,
+						long& NombrePoints,
+						const long NombreDimensions,
+						LabelArena* Labels)
 {
-	long i;
+	const long Capacite = CountLines( Debut, Fin);
+	matrice = new double[Capacite*NombreDimensions];
 
 	if( Labels)
+		Labels->Reserve(Capacite);
+
+	long Position;
+	long NombreTemp;
+	bool Retenue;
+	long NumLigne = 0;
+	NombrePoints = 0;
+
+	const char* Suivant;
+	for( const char* Ligne = Debut; Ligne != Fin; Ligne = Suivant)
+	{
+		const char* FinLigne = EndOfLine( Ligne, Fin, Suivant);
+		NumLigne++;
+
+		if( Ligne == FinLigne)
+		{
+			std::cout << "Line " << NumLigne << " empty" << std::endl;
+			break;
+		}
+
+		LineStatus Status = ParseLine( Ligne, FinLigne, delim, Plan, true, matrice, NombrePoints, Capacite, Labels, Retenue, Position, NombreTemp);
+		if( Status != LINE_OK)
+		{
+			ReportLineError( Status, NumLigne, Position, NombreTemp, Plan.NbColonnes);
+			delete[] matrice;
+			matrice = 0;
+			return false;
+		}
+		if( Retenue)
+			NombrePoints++;
+	}
+
+	// the columns have to be packed again
+	if( NombrePoints < Capacite)
+		for( long i = 1; i < NombreDimensions; i++)
+			memmove( matrice + i*NombrePoints, matrice + i*Capacite, NombrePoints * sizeof(double));
+
+	// most of the lines have been rejected, don't keep the memory they would have used
+	if( NombrePoints < Capacite / 2)
+	{
+		double* Reduite = new double[NombrePoints*NombreDimensions];
+		std::copy( matrice, matrice + NombrePoints*NombreDimensions, Reduite);
+		delete[] matrice;
+		matrice = Reduite;
+	}
+
+	return true;
+}
+
+/*
+ * Multi-threaded version of the loading loop, the first pass gives the row offset of each chunk
+ * so that the second one can fill matrice directly
+ */
+bool ParseChunks(	const char* Debut,
+					const char* Fin,
+					char delim,
+					unsigned NbThreads,
+					const FieldPlan& Plan,
+					double*& matrice,
+					long& NombrePoints,
+					const long NombreDimensions,
+					LabelArena* Labels)
+{
+	std::vector<Chunk> Chunks( NbThreads);
+
+	const char* Limite = Debut;
+	for( unsigned i = 0; i < NbThreads; i++)
+	{
+		Chunks[i].Debut = Limite;
+		if( i + 1 == NbThreads)
+			Limite = Fin;
+		else
+		{
+			Limite = std::max( Limite, Debut + (Fin - Debut) / NbThreads * (i + 1));
+			const char* FinLigne = static_cast<const char*>(memchr( Limite, '\n', Fin - Limite));
+			Limite = (FinLigne == 0) ? Fin : FinLigne + 1;
+		}
+		Chunks[i].Fin = Limite;
+	}
+
+	CountTask Comptage( Chunks, delim, Plan);
+	Utils::RunParallel( Comptage, NbThreads);
+
+	// everything after the first empty or erroneous line is ignored
+	NombrePoints = 0;
+	long NombreLignes = 0;
+	unsigned NbChunks = 0;
+	while( NbChunks < NbThreads)
 	{
-		std::string label;
-		size_t possep = Source.str().find_first_of( delim);
-		Source.width(possep);
-		Source >> label;
-		Labels->push_back(label);
-		Source.get();
+		Chunk& Morceau = Chunks[NbChunks++];
+		Morceau.PremiereLigne = NombreLignes;
+		Morceau.PremierPoint = NombrePoints;
+		NombreLignes += Morceau.NbLignes;
+		NombrePoints += Morceau.NbPoints;
+
+		if( Morceau.Arret)
+		{
+			if( Morceau.Status != LINE_OK)
+			{
+				ReportLineError( Morceau.Status, NombreLignes + 1, Morceau.Position, Morceau.NbChamps, Plan.NbColonnes);
+				return false;
+			}
+			std::cout << "Line " << NombreLignes + 1 << " empty" << std::endl;
+			break;
+		}
 	}
+	Chunks.resize( NbChunks);
 
-	for( i = 0; i < NombreDimensions; i++)
+	matrice = new double[NombrePoints*NombreDimensions];
+
+	ParseTask Conversion( Chunks, delim, Plan, matrice, NombrePoints);
+	Utils::RunParallel( Conversion, NbChunks);
+
+	for( unsigned i = 0; i < NbChunks; i++)
 	{
-		double pouet;
-		std::string pouetTemp;
-		Source >> pouetTemp;
-		if(!pouetTemp.compare("inf")){
-            		pouet = std::numeric_limits<double>::max();
-		}else{
-            		std::istringstream iss(pouetTemp);
-            		iss >> pouet;
+		if( Chunks[i].Status != LINE_OK)
+		{
+			ReportLineError( Chunks[i].Status, Chunks[i].PremiereLigne + Chunks[i].NbLignes + 1, Chunks[i].Position, Chunks[i].NbChamps, Plan.NbColonnes);
+			delete[] matrice;
+			matrice = 0;
+			return false;
 		}
-		matrice[i*NombrePoints + NumeroPoint] = pouet;
-		Source.get();
 	}
+
+	if( Labels)
+	{
+		Labels->Reserve( NombrePoints);
+		for( unsigned i = 0; i < NbChunks; i++)
+			Labels->Append( Chunks[i].Labels);
+	}
+
+	return true;
+}
+
 }
 
+
 bool ParseFileIntoMatrix(	const char* FileName,
 							size_t NumDimExpected,
 							double*& matrice,
 							long& NombrePoints,
 							long& NombreDimensions,
-							std::vector<std::string>* Labels )
+							LabelArena* Labels,
+							unsigned NbThreads,
+							const LoadFilter* Filtre )
 {
-	std::ifstream FichierEntree( FileName);
+	MappedFile Fichier;
 
-	if( ! FichierEntree.is_open())
+	if( ! Fichier.Open( FileName))
 		return false;
 
-	std::string ligne;
-	getline( FichierEntree, ligne);
+	const char* Debut = Fichier.Data();
+	const char* Fin = Debut + Fichier.Size();
+	const char* Suivant;
+	const char* FinLigne = EndOfLine( Debut, Fin, Suivant);
 
-	int posdelim = ligne.find_first_of( " ,");
-	if(posdelim == std::string::npos)
+	const char* posdelim = Debut;
+	while( posdelim != FinLigne && *posdelim != ' ' && *posdelim != ',')
+		++posdelim;
+	if( posdelim == FinLigne)
 	{
 		std::cout << "No delimiter (either space or comma) found in the first line" << std::endl;
 		return false;
 	}
 
-	char delim = ligne[posdelim];
+	char delim = *posdelim;
 	std::cout << "Delimiter found: ";
 	switch(delim)
 	{
@@ -110,11 +658,15 @@ bool ParseFileIntoMatrix(	const char* FileName,
 	}
 	std::cout << std::endl;
 
-	NombreDimensions = StringTokenCounter( ligne, delim);
+	long NombreColonnes = 1 + std::count( Debut, FinLigne, delim);
 
 	// Is the first column for labels?
 	if( Labels)
-		NombreDimensions--;
+		NombreColonnes--;
+
+	FieldPlan Plan;
+	if( ! BuildPlan( Filtre, NombreColonnes, Labels != 0, Plan, NombreDimensions))
+		return false;
 
 	if( NombreDimensions == 0)
 		return false;
@@ -126,54 +678,19 @@ bool ParseFileIntoMatrix(	const char* FileName,
 		return false;
 	}
 
-	long NombreTemp;
-	NombrePoints = 1;
-
-	while( ! FichierEntree.eof())
-	{
-		getline( FichierEntree, ligne);
-		NombreTemp = StringTokenCounter( ligne, delim);
+	bool Ok;
+	if( NbThreads > 1)
+		Ok = ParseChunks( Debut, Fin, delim, NbThreads, Plan, matrice, NombrePoints, NombreDimensions, Labels);
+	else
+		Ok = ParseSinglePass( Debut, Fin, delim, Plan, matrice, NombrePoints, NombreDimensions, Labels);
 
-		if( NombreTemp < 0)
-		{
-			std::cout << "Empty field line " << NombrePoints + 1 << " character " << -NombreTemp << std::endl;
-			return false;
-		}
-
-		if( NombreTemp == 0)
-		{
-			std::cout << "Line " << NombrePoints + 1 << " empty" << std::endl;
-			break;
-		}
-
-		if( Labels)
-			NombreTemp--;
-
-		if( NombreTemp != NombreDimensions)
-		{
-			std::cout << "Line " << NombrePoints + 1 << " : " << NombreTemp << " dimensions instead of " << NombreDimensions << std::endl;
-			return false;
-		}
-
-		NombrePoints++;
-	}
-
-	std::cout << "Loading " << NombrePoints << " elements in " << NombreDimensions << " dimensions" << std::endl;
-
-	matrice = new double[NombrePoints*NombreDimensions];
-
-	if( Labels)
-		Labels->reserve(NombrePoints);
-
-	FichierEntree.close();
-	FichierEntree.open( FileName);
+	if( ! Ok)
+		return false;
 
-	for( long i = 0; i < NombrePoints; i++)
-	{
-		getline( FichierEntree, ligne);
-		std::istringstream iss( ligne);
-		StringTokenizer( iss, matrice, i, NombrePoints, NombreDimensions, delim, Labels);
-	}
+	std::cout << "Loaded " << NombrePoints << " elements in " << NombreDimensions << " dimensions";
+	if( NombreDimensions != NombreColonnes)
+		std::cout << " (out of " << NombreColonnes << ")";
+	std::cout << std::endl;
 
 	return true;
 }
@@ -28,12 +28,42 @@
 #include <vector>
 #include <limits>
 
+#include "labels.h"
 
+
+/*
+ * Part of the file to load, columns being numbered from zero without the label one
+ * Only the fields of the selected or filtered columns are converted
+ */
+struct LoadFilter
+{
+	struct Intervalle
+	{
+		long Colonne;
+		double Min;
+		double Max;
+	};
+
+	std::vector<long> Colonnes;				// dimensions of matrice in order, all the columns if empty
+	std::vector<Intervalle> Intervalles;	// a line is kept if all its values are within [Min, Max]
+};
+
+
+/*
+ * Loads a space or comma separated file in a single pass into the column-major matrice
+ * (value of point j on dimension i at i*NombrePoints + j), "-" reads the standard input
+ * With NbThreads > 1 the file is split on line boundaries, each thread counting then
+ * converting its own part
+ * NumDimExpected and NombreDimensions refer to the selected columns if Filtre is given,
+ * error messages always give the line numbers of the file
+ */
 bool ParseFileIntoMatrix(	const char* FileName, size_t NumDimExpected,
 							double*& matrice,
 							long& NombrePoints,
 							long& NombreDimensions,
-							std::vector<std::string>* Labels = 0 );
+							LabelArena* Labels = 0,
+							unsigned NbThreads = 1,
+							const LoadFilter* Filtre = 0 );
 
 
 #endif /*READFILE_H_*/
@@ -0,0 +1,602 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include <algorithm>
+#include <limits>
+
+#include "skytree.h"
+#include "utils.h"
+
+
+namespace {
+
+// below this size a region is solved by block nested loops
+const long TailleFeuille = 64;
+
+// and past this depth as well, in case the pivots keep splitting off a few points only
+const int ProfondeurMax = 32;
+
+}
+
+
+template<typename T>
+PartitionSkyline<T>::PartitionSkyline(	const T* Vue_p,
+										long PasDimension_p,
+										long PasPoint_p,
+										const std::vector<bool>& FindLowest_p,
+										const LatticePath& Chemin_p ) :
+	Vue( Vue_p),
+	PasDimension( PasDimension_p),
+	PasPoint( PasPoint_p),
+	FindLowest( FindLowest_p),
+	Chemin( Chemin_p),
+	ComparePoints( Vue_p, PasDimension_p, PasPoint_p, FindLowest_p, Chemin_p)
+{
+	for( LatticePath::const_iterator iteChemin = Chemin.begin(); iteChemin != Chemin.end(); ++iteChemin)
+	{
+		Decalages.push_back( *iteChemin * PasDimension);
+		Inverse.push_back( ! FindLowest[*iteChemin]);
+	}
+}
+
+template<typename T>
+void PartitionSkyline<T>::Compute( std::vector<PointId>& Points, DotSet& TempD, CombinedSkyline& TempI)
+{
+	std::vector<PointId> Skyline;
+	std::vector< std::pair<PointId,PointId> > Paires;
+	Compute( Points, Skyline, Paires);
+	BuildSkyline( Skyline, Paires, TempD, TempI);
+}
+
+template<typename T>
+void PartitionSkyline<T>::Compute( std::vector<PointId>& Points, std::vector<PointId>& Skyline, std::vector< std::pair<PointId,PointId> >& Paires)
+{
+	Combines.clear();
+	if( ! Points.empty())
+		Partition( &Points[0], &Points[0] + Points.size(), Skyline, 0);
+	Paires.insert( Paires.end(), Combines.begin(), Combines.end());
+}
+
+/*
+ * Appends the representatives of the skyline of [Debut, Fin) to Skyline, the range being
+ * used as scratch space
+ */
+template<typename T>
+void PartitionSkyline<T>::Partition( PointId* Debut, PointId* Fin, std::vector<PointId>& Skyline, int Profondeur)
+{
+	if( Fin - Debut <= TailleFeuille || Profondeur == ProfondeurMax)
+	{
+		Window( Debut, Fin, Skyline);
+		return;
+	}
+
+	const PointId Pivot = SelectPivot( Debut, Fin);
+	const size_t NbDims = Chemin.size();
+	const uint64_t Plein = NbDims == 64 ? ~uint64_t(0) : (uint64_t(1) << NbDims) - 1;
+
+	// region of every other point, the ones in region Plein are dominated by the pivot or combined with it
+	std::vector< std::pair<uint64_t,PointId> > Regions;
+	Regions.reserve( Fin - Debut);
+	for( const PointId* itePoint = Debut; itePoint != Fin; ++itePoint)
+	{
+		if( *itePoint == Pivot)
+			continue;
+
+		uint64_t Masque = 0;
+		bool Egal = true;
+		for( size_t k = 0; k < NbDims; k++)
+		{
+			const double v = Value( *itePoint, k);
+			const double p = Value( Pivot, k);
+			if( Inverse[k] ? !( p < v) : !( v < p))
+				Masque |= uint64_t(1) << k;
+			Egal = Egal && v == p;
+		}
+
+		if( Egal)
+			Combines.push_back( std::make_pair( Pivot, *itePoint));
+		else if( Masque != Plein)
+			Regions.push_back( std::make_pair( Masque, *itePoint));
+	}
+
+	Skyline.push_back( Pivot);
+
+	// a region included in another one comes first
+	std::sort( Regions.begin(), Regions.end());
+	for( size_t i = 0; i < Regions.size(); i++)
+		Debut[i] = Regions[i].second;
+
+	// the skyline of every region solved so far, dimension after dimension as CompareOneToMany reads it
+	std::vector<uint64_t> Masques;
+	std::vector<PointId> SkylineRegions;
+	std::vector<T> Blocs;
+	std::vector<size_t> DebutBlocs;
+	std::vector<long> Capacites;
+	std::vector<long> Tailles;
+	std::vector<T> Candidat( NbDims);
+	std::vector<uint64_t> Dominant, Domine, Equivalent;
+
+	for( size_t Premier = 0, Dernier; Premier < Regions.size(); Premier = Dernier)
+	{
+		const uint64_t Masque = Regions[Premier].first;
+		for( Dernier = Premier + 1; Dernier < Regions.size() && Regions[Dernier].first == Masque; Dernier++)
+			;
+
+		// only the points of the included regions can dominate those of this one
+		PointId* Retenu = Debut + Premier;
+		for( PointId* itePoint = Debut + Premier; itePoint != Debut + Dernier; ++itePoint)
+		{
+			const T* Point = Vue + *itePoint * PasPoint;
+			for( size_t k = 0; k < NbDims; k++)
+				Candidat[k] = Point[ Decalages[k] ];
+
+			bool Battu = false;
+			for( size_t r = 0; ! Battu && r < Masques.size(); r++)
+				if( (Masques[r] & Masque) == Masques[r] && Tailles[r] > 0)
+					Battu = ! CompareOneToMany( &Candidat[0], &Blocs[DebutBlocs[r]], Capacites[r], Tailles[r], NbDims, &Inverse[0],
+													&Dominant[0], &Domine[0], &Equivalent[0]);
+
+			if( ! Battu)
+				*Retenu++ = *itePoint;
+		}
+
+		const size_t Avant = SkylineRegions.size();
+		Partition( Debut + Premier, Retenu, SkylineRegions, Profondeur + 1);
+
+		const long Taille = SkylineRegions.size() - Avant;
+		const long Capacite = (Taille + 63) / 64 * 64;
+		Masques.push_back( Masque);
+		DebutBlocs.push_back( Blocs.size());
+		Capacites.push_back( Capacite);
+		Tailles.push_back( Taille);
+		Blocs.resize( Blocs.size() + Capacite * NbDims);
+		for( long e = 0; e < Taille; e++)
+		{
+			const T* Point = Vue + SkylineRegions[Avant + e] * PasPoint;
+			for( size_t k = 0; k < NbDims; k++)
+				Blocs[DebutBlocs.back() + k * Capacite + e] = Point[ Decalages[k] ];
+		}
+		if( static_cast<long>(Dominant.size()) < Capacite / 64)
+		{
+			Dominant.resize( Capacite / 64);
+			Domine.resize( Capacite / 64);
+			Equivalent.resize( Capacite / 64);
+		}
+	}
+
+	Skyline.insert( Skyline.end(), SkylineRegions.begin(), SkylineRegions.end());
+}
+
+/*
+ * The point whose worst normalized value is the lowest splits the others evenly, it is then
+ * replaced by any point dominating it so that it belongs to the skyline
+ */
+template<typename T>
+PointId PartitionSkyline<T>::SelectPivot( const PointId* Debut, const PointId* Fin) const
+{
+	const size_t NbDims = Chemin.size();
+	std::vector<double> Min( NbDims), Max( NbDims);
+	for( size_t k = 0; k < NbDims; k++)
+		Min[k] = Max[k] = Value( *Debut, k);
+	for( const PointId* itePoint = Debut + 1; itePoint != Fin; ++itePoint)
+		for( size_t k = 0; k < NbDims; k++)
+		{
+			const double v = Value( *itePoint, k);
+			Min[k] = std::min( Min[k], v);
+			Max[k] = std::max( Max[k], v);
+		}
+
+	PointId Pivot = *Debut;
+	double MeilleurPire = 0;
+	for( const PointId* itePoint = Debut; itePoint != Fin; ++itePoint)
+	{
+		double Pire = 0;
+		for( size_t k = 0; k < NbDims; k++)
+		{
+			const double Etendue = Max[k] - Min[k];
+			if( Etendue > 0)		// also false for infinite or undefined ranges
+			{
+				const double v = Value( *itePoint, k);
+				Pire = std::max( Pire, (Inverse[k] ? Max[k] - v : v - Min[k]) / Etendue);
+			}
+		}
+
+		if( itePoint == Debut || Pire < MeilleurPire)
+		{
+			Pivot = *itePoint;
+			MeilleurPire = Pire;
+		}
+	}
+
+	for( const PointId* itePoint = Debut; itePoint != Fin; ++itePoint)
+		if( ComparePoints( *itePoint, Pivot) == P1_DOM_P2)
+			Pivot = *itePoint;
+
+	return Pivot;
+}
+
+template<typename T>
+void PartitionSkyline<T>::Window( const PointId* Debut, const PointId* Fin, std::vector<PointId>& Skyline)
+{
+	DominanceWindow<T> Fenetre( Vue, PasDimension, PasPoint, FindLowest, Chemin);
+	for( const PointId* itePoint = Debut; itePoint != Fin; ++itePoint)
+		Fenetre.Insert( *itePoint);
+	Fenetre.Extract( Skyline, Combines);
+}
+
+
+
+void BuildSkyline(	std::vector<PointId>& Skyline,
+					std::vector< std::pair<PointId,PointId> >& Paires,
+					DotSet& TempD,
+					CombinedSkyline& TempI )
+{
+	std::sort( Skyline.begin(), Skyline.end());
+	std::sort( Paires.begin(), Paires.end());
+
+	std::vector<PointId> Seuls;
+	DotSet Groupe;
+	std::vector< std::pair<PointId,PointId> >::const_iterator itePaire = Paires.begin();
+	for( std::vector<PointId>::const_iterator iteSky = Skyline.begin(); iteSky != Skyline.end(); ++iteSky)
+	{
+		while( itePaire != Paires.end() && itePaire->first < *iteSky)
+			++itePaire;
+
+		if( itePaire == Paires.end() || itePaire->first != *iteSky)
+		{
+			Seuls.push_back( *iteSky);
+			continue;
+		}
+
+		Groupe.clear();
+		Groupe.insert( *iteSky);
+		for( ; itePaire != Paires.end() && itePaire->first == *iteSky; ++itePaire)
+			Groupe.insert( itePaire->second);
+		TempI.insert( Groupe);
+	}
+
+	TempD.insert( Seuls.begin(), Seuls.end());
+}
+
+
+namespace {
+
+/*
+ * LOCAL: every thread computes the skyline of its share of the points
+ * REGIONS: every thread splits its local skyline into the regions of a pivot common to all
+ * of them, each region being stored dimension after dimension for CompareOneToMany
+ * MERGE: every thread drops the points of its local skyline dominated by a point of the
+ * regions of the other ones included in theirs, a point combined with one of a lower share
+ * joining it
+ */
+template<typename T>
+class ParallelSkylineTask : public ParallelTask
+{
+public:
+	enum ETAPE { LOCAL, REGIONS, MERGE };
+
+	ParallelSkylineTask(	const T* Vue_p,
+							long PasDimension_p,
+							long PasPoint_p,
+							const std::vector<bool>& FindLowest_p,
+							const LatticePath& Chemin_p,
+							long NombrePoints,
+							unsigned NbParts ) :
+		Vue( Vue_p),
+		PasDimension( PasDimension_p),
+		PasPoint( PasPoint_p),
+		FindLowest( FindLowest_p),
+		Chemin( Chemin_p),
+		Etape( LOCAL),
+		Bornes( NbParts + 1),
+		Skylines( NbParts),
+		Paires( NbParts),
+		Parts( NbParts),
+		Retenus( NbParts),
+		Renvois( NbParts)
+	{
+		for( unsigned c = 0; c <= NbParts; c++)
+			Bornes[c] = NombrePoints * c / NbParts;
+		for( LatticePath::const_iterator iteChemin = Chemin.begin(); iteChemin != Chemin.end(); ++iteChemin)
+		{
+			Decalages.push_back( *iteChemin * PasDimension);
+			Inverse.push_back( ! FindLowest[*iteChemin]);
+		}
+	}
+
+	void SetStep( ETAPE Etape_p)						{ Etape = Etape_p; }
+
+	void Run( unsigned NumThread)
+	{
+		switch( Etape)
+		{
+			case LOCAL:		Local( NumThread);		break;
+			case REGIONS:	Split( NumThread);		break;
+			case MERGE:		Merge( NumThread);		break;
+		}
+	}
+
+	/*
+	 * The local skyline point whose worst normalized value is the lowest, as in
+	 * PartitionSkyline::SelectPivot, any point would do but this one splits them evenly
+	 */
+	void SelectPivot()
+	{
+		const size_t NbDims = Chemin.size();
+		std::vector<double> Min( NbDims, std::numeric_limits<double>::infinity());
+		std::vector<double> Max( NbDims, -std::numeric_limits<double>::infinity());
+		for( size_t c = 0; c < Skylines.size(); c++)
+			for( size_t e = 0; e < Skylines[c].size(); e++)
+				for( size_t k = 0; k < NbDims; k++)
+				{
+					const double v = Value( Skylines[c][e], k);
+					Min[k] = std::min( Min[k], v);
+					Max[k] = std::max( Max[k], v);
+				}
+
+		double MeilleurPire = std::numeric_limits<double>::infinity();
+		Pivot.assign( NbDims, 0);
+		for( size_t c = 0; c < Skylines.size(); c++)
+			for( size_t e = 0; e < Skylines[c].size(); e++)
+			{
+				double Pire = 0;
+				for( size_t k = 0; k < NbDims; k++)
+				{
+					const double Etendue = Max[k] - Min[k];
+					if( Etendue > 0)
+					{
+						const double v = Value( Skylines[c][e], k);
+						Pire = std::max( Pire, (Inverse[k] ? Max[k] - v : v - Min[k]) / Etendue);
+					}
+				}
+
+				if( ! (Pire >= MeilleurPire))
+				{
+					for( size_t k = 0; k < NbDims; k++)
+						Pivot[k] = Value( Skylines[c][e], k);
+					MeilleurPire = Pire;
+				}
+			}
+	}
+
+	// gathers the surviving representatives and the pairs of their groups
+	void Collect( std::vector<PointId>& Skyline, std::vector< std::pair<PointId,PointId> >& Groupes) const
+	{
+		std::vector< std::pair<PointId,PointId> > Fusions;
+		for( size_t c = 0; c < Skylines.size(); c++)
+		{
+			Skyline.insert( Skyline.end(), Retenus[c].begin(), Retenus[c].end());
+			Groupes.insert( Groupes.end(), Paires[c].begin(), Paires[c].end());
+			for( size_t f = 0; f < Renvois[c].size(); f++)
+			{
+				Groupes.push_back( Renvois[c][f]);
+				Fusions.push_back( std::make_pair( Renvois[c][f].second, Renvois[c][f].first));
+			}
+		}
+
+		// the elements combined with a representative that joined another group follow it
+		std::sort( Fusions.begin(), Fusions.end());
+		for( size_t g = 0; g < Groupes.size(); g++)
+		{
+			std::vector< std::pair<PointId,PointId> >::const_iterator iteFusion =
+				std::lower_bound( Fusions.begin(), Fusions.end(), std::make_pair( Groupes[g].first, PointId( 0)));
+			if( iteFusion != Fusions.end() && iteFusion->first == Groupes[g].first)
+				Groupes[g].first = iteFusion->second;
+		}
+	}
+
+private:
+	// regions of a local skyline, whose points are sorted by region
+	struct Part
+	{
+		std::vector<uint64_t> Masques;
+		std::vector<long> Premiers;			// index in the local skyline of the first point of each region
+		std::vector<long> Tailles;
+		std::vector<long> Capacites;
+		std::vector<size_t> DebutBlocs;
+		std::vector<T> Blocs;
+		std::vector<uint64_t> MasquesPoints;
+	};
+
+	double Value( PointId Point, size_t k) const			{ return Vue[ Point * PasPoint + Decalages[k] ]; }
+
+	void Local( unsigned c)
+	{
+		std::vector<PointId> Points;
+		for( long j = Bornes[c]; j < Bornes[c+1]; j++)
+			Points.push_back( j);
+		PartitionSkyline<T>( Vue, PasDimension, PasPoint, FindLowest, Chemin).Compute( Points, Skylines[c], Paires[c]);
+	}
+
+	void Split( unsigned c)
+	{
+		const size_t NbDims = Chemin.size();
+		std::vector< std::pair<uint64_t,PointId> > Tri;
+		Tri.reserve( Skylines[c].size());
+		for( size_t e = 0; e < Skylines[c].size(); e++)
+		{
+			uint64_t Masque = 0;
+			for( size_t k = 0; k < NbDims; k++)
+			{
+				const double v = Value( Skylines[c][e], k);
+				if( Inverse[k] ? !( Pivot[k] < v) : !( v < Pivot[k]))
+					Masque |= uint64_t(1) << k;
+			}
+			Tri.push_back( std::make_pair( Masque, Skylines[c][e]));
+		}
+		std::sort( Tri.begin(), Tri.end());
+
+		Part& Decoupe = Parts[c];
+		for( size_t e = 0; e < Tri.size(); e++)
+		{
+			Skylines[c][e] = Tri[e].second;
+			Decoupe.MasquesPoints.push_back( Tri[e].first);
+		}
+
+		for( size_t Premier = 0, Dernier; Premier < Tri.size(); Premier = Dernier)
+		{
+			for( Dernier = Premier + 1; Dernier < Tri.size() && Tri[Dernier].first == Tri[Premier].first; Dernier++)
+				;
+
+			const long Taille = Dernier - Premier;
+			const long Capacite = (Taille + 63) / 64 * 64;
+			Decoupe.Masques.push_back( Tri[Premier].first);
+			Decoupe.Premiers.push_back( Premier);
+			Decoupe.Tailles.push_back( Taille);
+			Decoupe.Capacites.push_back( Capacite);
+			Decoupe.DebutBlocs.push_back( Decoupe.Blocs.size());
+			Decoupe.Blocs.resize( Decoupe.Blocs.size() + Capacite * NbDims);
+			for( long e = 0; e < Taille; e++)
+			{
+				const T* Point = Vue + Tri[Premier + e].second * PasPoint;
+				for( size_t k = 0; k < NbDims; k++)
+					Decoupe.Blocs[Decoupe.DebutBlocs.back() + k * Capacite + e] = Point[ Decalages[k] ];
+			}
+		}
+	}
+
+	void Merge( unsigned c)
+	{
+		const size_t NbDims = Chemin.size();
+		long CapaciteMax = 0;
+		for( size_t Autre = 0; Autre < Parts.size(); Autre++)
+			for( size_t r = 0; r < Parts[Autre].Capacites.size(); r++)
+				CapaciteMax = std::max( CapaciteMax, Parts[Autre].Capacites[r]);
+		std::vector<uint64_t> Dominant( CapaciteMax / 64 + 1), Domine( CapaciteMax / 64 + 1), Equivalent( CapaciteMax / 64 + 1);
+		std::vector<T> Candidat( NbDims);
+
+		for( size_t e = 0; e < Skylines[c].size(); e++)
+		{
+			const PointId Point = Skylines[c][e];
+			const uint64_t Masque = Parts[c].MasquesPoints[e];
+			const T* Valeurs = Vue + Point * PasPoint;
+			for( size_t k = 0; k < NbDims; k++)
+				Candidat[k] = Valeurs[ Decalages[k] ];
+
+			bool Retenu = true;
+			for( size_t Autre = 0; Retenu && Autre < Parts.size(); Autre++)
+			{
+				if( Autre == c)
+					continue;
+
+				// only the points of the included regions can dominate this one or be combined with it
+				const Part& Decoupe = Parts[Autre];
+				for( size_t r = 0; Retenu && r < Decoupe.Masques.size() && Decoupe.Masques[r] <= Masque; r++)
+				{
+					if( (Decoupe.Masques[r] & Masque) != Decoupe.Masques[r] ||
+						CompareOneToMany( &Candidat[0], &Decoupe.Blocs[Decoupe.DebutBlocs[r]], Decoupe.Capacites[r], Decoupe.Tailles[r], NbDims,
+											&Inverse[0], &Dominant[0], &Domine[0], &Equivalent[0]))
+						continue;
+
+					// a local skyline holds incomparable points: the first one found decides
+					for( long Mot = 0; Mot * 64 < Decoupe.Tailles[r]; Mot++)
+						if( Domine[Mot] != 0)
+						{
+							Retenu = false;
+							break;
+						}
+						else if( Equivalent[Mot] != 0)
+						{
+							// the lowest share keeps the group, whose fate it then decides
+							if( Autre < c)
+							{
+								const long Rang = Decoupe.Premiers[r] + Mot * 64 + __builtin_ctzll( Equivalent[Mot]);
+								Renvois[c].push_back( std::make_pair( Skylines[Autre][Rang], Point));
+								Retenu = false;
+							}
+							break;
+						}
+				}
+			}
+
+			if( Retenu)
+				Retenus[c].push_back( Point);
+		}
+	}
+
+	const T* const Vue;
+	const long PasDimension;
+	const long PasPoint;
+	const std::vector<bool>& FindLowest;
+	const LatticePath& Chemin;
+	std::vector<long> Decalages;
+	std::vector<char> Inverse;
+	ETAPE Etape;
+
+	std::vector<long> Bornes;										// share c is [Bornes[c], Bornes[c+1])
+	std::vector< std::vector<PointId> > Skylines;
+	std::vector< std::vector< std::pair<PointId,PointId> > > Paires;
+	std::vector<double> Pivot;
+	std::vector<Part> Parts;
+	std::vector< std::vector<PointId> > Retenus;
+	std::vector< std::vector< std::pair<PointId,PointId> > > Renvois;		// (representative kept, representative joining it)
+};
+
+}
+
+
+template<typename T>
+void ParallelSkyline(	const T* Vue,
+						long PasDimension,
+						long PasPoint,
+						const std::vector<bool>& FindLowest,
+						const LatticePath& Chemin,
+						long NombrePoints,
+						unsigned NbThreads,
+						DotSet& TempD,
+						CombinedSkyline& TempI )
+{
+	// too few points to be worth splitting
+	if( NbThreads > static_cast<unsigned long>(NombrePoints / 1024))
+		NbThreads = std::max( NombrePoints / 1024, 1L);
+
+	if( NbThreads <= 1)
+	{
+		std::vector<PointId> Points( NombrePoints);
+		for( long j = 0; j < NombrePoints; j++)
+			Points[j] = j;
+		PartitionSkyline<T>( Vue, PasDimension, PasPoint, FindLowest, Chemin).Compute( Points, TempD, TempI);
+		return;
+	}
+
+	ParallelSkylineTask<T> Tache( Vue, PasDimension, PasPoint, FindLowest, Chemin, NombrePoints, NbThreads);
+	Utils::RunParallel( Tache, NbThreads);
+	Tache.SelectPivot();
+	Tache.SetStep( ParallelSkylineTask<T>::REGIONS);
+	Utils::RunParallel( Tache, NbThreads);
+	Tache.SetStep( ParallelSkylineTask<T>::MERGE);
+	Utils::RunParallel( Tache, NbThreads);
+
+	std::vector<PointId> Skyline;
+	std::vector< std::pair<PointId,PointId> > Groupes;
+	Tache.Collect( Skyline, Groupes);
+	BuildSkyline( Skyline, Groupes, TempD, TempI);
+}
+
+
+template class PartitionSkyline<double>;
+template class PartitionSkyline<uint32_t>;
+template class PartitionSkyline<float>;
+template class PartitionSkyline<int32_t>;
+
+template void ParallelSkyline( const double*, long, long, const std::vector<bool>&, const LatticePath&, long, unsigned, DotSet&, CombinedSkyline&);
+template void ParallelSkyline( const uint32_t*, long, long, const std::vector<bool>&, const LatticePath&, long, unsigned, DotSet&, CombinedSkyline&);
+template void ParallelSkyline( const float*, long, long, const std::vector<bool>&, const LatticePath&, long, unsigned, DotSet&, CombinedSkyline&);
+template void ParallelSkyline( const int32_t*, long, long, const std::vector<bool>&, const LatticePath&, long, unsigned, DotSet&, CombinedSkyline&);
@@ -0,0 +1,107 @@
+/*
+ * Orion Skycube Computing v1.0
+ * Copyright (C) 2010 Thomas Kister
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef SKYTREE_H_
+#define SKYTREE_H_
+
+
+#include <stdint.h>
+#include <vector>
+
+#include "defs.h"
+#include "dominance.h"
+
+
+/*
+ * Partition-based skyline in the spirit of BSkyTree
+ * A pivot taken from the skyline splits the other points into regions, region B holding
+ * the points that are not better than the pivot on the dimensions of the bit-vector B.
+ * A point can only be dominated by a point of a region included in its own, so the regions
+ * are solved recursively in increasing order and only compared to the regions they include.
+ * Small regions are left to a DominanceWindow
+ */
+template<typename T>
+class PartitionSkyline
+{
+public:
+	// same layout as DominanceWindow, at most 64 dimensions in Chemin
+	PartitionSkyline(	const T* Vue,
+						long PasDimension,
+						long PasPoint,
+						const std::vector<bool>& FindLowest,
+						const LatticePath& Chemin );
+
+	/*
+	 * Skyline of Points (reordered on return), the single points go to TempD and the groups
+	 * of combined points to TempI
+	 */
+	void Compute( std::vector<PointId>& Points, DotSet& TempD, CombinedSkyline& TempI);
+
+	// or its representatives to Skyline, every other element being paired with its own in Paires
+	void Compute( std::vector<PointId>& Points, std::vector<PointId>& Skyline, std::vector< std::pair<PointId,PointId> >& Paires);
+
+private:
+	void Partition( PointId* Debut, PointId* Fin, std::vector<PointId>& Skyline, int Profondeur);
+	PointId SelectPivot( const PointId* Debut, const PointId* Fin) const;
+	void Window( const PointId* Debut, const PointId* Fin, std::vector<PointId>& Skyline);
+
+	double Value( PointId Point, size_t k) const			{ return Vue[ Point * PasPoint + Decalages[k] ]; }
+
+	const T* const Vue;
+	const long PasDimension;
+	const long PasPoint;
+	const std::vector<bool>& FindLowest;
+	const LatticePath& Chemin;
+	std::vector<long> Decalages;
+	std::vector<char> Inverse;
+	PathComparator<T> ComparePoints;
+
+	std::vector< std::pair<PointId,PointId> > Combines;		// (representative, element combined with it)
+};
+
+
+/*
+ * Fills TempD and TempI from the representatives of a skyline and the (representative, element)
+ * pairs of its groups, ignoring the pairs whose representative isn't in Skyline
+ * Both vectors are sorted on return
+ */
+void BuildSkyline(	std::vector<PointId>& Skyline,
+					std::vector< std::pair<PointId,PointId> >& Paires,
+					DotSet& TempD,
+					CombinedSkyline& TempI );
+
+/*
+ * Skyline of the points 0 to NombrePoints-1 computed on NbThreads threads: each of them
+ * partitions its share of the points, then checks the local skyline it found against the
+ * local skylines of the others
+ */
+template<typename T>
+void ParallelSkyline(	const T* Vue,
+						long PasDimension,
+						long PasPoint,
+						const std::vector<bool>& FindLowest,
+						const LatticePath& Chemin,
+						long NombrePoints,
+						unsigned NbThreads,
+						DotSet& TempD,
+						CombinedSkyline& TempI );
+
+
+#endif // SKYTREE_H_
@@ -18,9 +18,29 @@
  */
 
 
+#include <pthread.h>
+
 #include "utils.h"
 
 
+namespace {
+
+struct ThreadArgs
+{
+	ParallelTask* Task;
+	unsigned NumThread;
+};
+
+void* ThreadMain( void* p)
+{
+	ThreadArgs* Args = static_cast<ThreadArgs*>(p);
+	Args->Task->Run( Args->NumThread);
+	return 0;
+}
+
+}
+
+
 void Utils::GetTime( timespec& now)
 {
 	clock_gettime( CLOCK_MONOTONIC, &now);
@@ -56,15 +76,47 @@ void Utils::DisplayTime( const timespec& disp, std::ostream& Cout)
 	Cout << disp.tv_nsec << " second(s)";
 }
 
+void Utils::RunParallel( ParallelTask& Task, unsigned NbThreads)
+{
+	if( NbThreads < 1)
+		NbThreads = 1;
+
+	std::vector<pthread_t> Threads( NbThreads);
+	std::vector<ThreadArgs> Args( NbThreads);
+	std::vector<bool> Started( NbThreads, false);
+
+	for( unsigned i = 1; i < NbThreads; i++)
+	{
+		Args[i].Task = &Task;
+		Args[i].NumThread = i;
+		Started[i] = pthread_create( &Threads[i], 0, ThreadMain, &Args[i]) == 0;
+	}
+
+	Task.Run( 0);
+
+	for( unsigned i = 1; i < NbThreads; i++)
+	{
+		if( Started[i])
+			pthread_join( Threads[i], 0);
+		else
+			Task.Run( i);			// couldn't get a thread, do its share here
+	}
+}
+
 
 Cnk::Cnk( unsigned long p_NbDim) :
 	NbDim( p_NbDim),
-	VecCnk( p_NbDim+1, 0)
+	VecCnk( p_NbDim+1, 0),
+	Pascal( (p_NbDim+1) * (p_NbDim+1), 0)
 {
-	VecCnk[0] = 1;
-	for( unsigned long i = 0; i < NbDim; i++)
-		for( unsigned long j = NbDim; j > 0; j--)
-			VecCnk[j] += VecCnk[j-1];
+	for( unsigned long n = 0; n <= NbDim; n++)
+	{
+		Pascal[ n * (NbDim + 1)] = 1;
+		for( unsigned long k = 1; k <= n; k++)
+			Pascal[ n * (NbDim + 1) + k] = Pascal[ (n - 1) * (NbDim + 1) + k - 1] + Pascal[ (n - 1) * (NbDim + 1) + k];
+	}
+
+	VecCnk.assign( Pascal.begin() + NbDim * (NbDim + 1), Pascal.end());
 }
 
 unsigned long Cnk::Value( unsigned long index)
@@ -31,6 +31,18 @@
 #endif // __APPLE__
 
 
+/*
+ * Work split between several threads, Run is called once by each of them
+ */
+class ParallelTask
+{
+public:
+	virtual ~ParallelTask() {}
+
+	virtual void Run( unsigned NumThread) = 0;
+};
+
+
 class Utils
 {
 public:
@@ -41,6 +53,12 @@ public:
 	static timespec GetDiffTime( const timespec& beg, const timespec& end);
 
 	static void DisplayTime( const timespec& disp, std::ostream& Cout);
+
+	/*
+	 * Calls Task.Run with 0 to NbThreads-1 on as many threads, the calling one
+	 * included, and returns once all of them are done
+	 */
+	static void RunParallel( ParallelTask& Task, unsigned NbThreads);
 };
 
 
@@ -49,11 +67,16 @@ class Cnk
 public:
 	Cnk( unsigned long p_NbDim);
 
+	// number of subspaces of index dimensions among NbDim
 	unsigned long Value( unsigned long index);
 
+	// n choose k for n and k up to NbDim, 0 if k > n
+	unsigned long Binomial( unsigned long n, unsigned long k) const	{ return Pascal[ n * (NbDim + 1) + k]; }
+
 private:
 	const unsigned long NbDim;
 	std::vector<unsigned long> VecCnk;
+	std::vector<unsigned long> Pascal;		// the triangle, one row of NbDim+1 values per n
 };
 
 
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+#
+# Times Orion on generated data sets: wall time, CPU time and peak resident
+# memory of every run. It isn't part of ctest, each case takes a few minutes.
+#
+# usage: benchmark.py ORION CASE [THREADS]
+#   rowmajor  depth and breadth on 10 dimensions, with and without -rowmajor
+#   lastnode  depth, whose node of all dimensions is shared between the threads,
+#             with -j 1, 2, 4... up to THREADS
+#   breadth   breadth and br_dom, whose levels are shared between the threads,
+#             with -j 1, 2, 4... up to THREADS
+# THREADS defaults to the number of cores
+
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+
+# the rows are generated one by one: the peak memory of Orion, forked from here,
+# would otherwise include them
+def independent( d):
+	return [random.randint( 0, 1000) for _ in range( d)]
+
+
+# without ties, for the skyline of the node of all dimensions to be large
+def uniform( d):
+	return ['%.6f' % random.random() for _ in range( d)]
+
+
+# the values of a point stay close to each other, which gives small skylines
+def correlated( d):
+	base = random.randint( 0, 950)
+	return [base + random.randint( 0, 50) for _ in range( d)]
+
+
+# the points are spread around the plane sum = constant, which gives large skylines
+def anticorrelated( d):
+	s = random.uniform( 0.4, 0.6)
+	r = [random.random() for _ in range( d)]
+	t = sum( r)
+	return [round( x / t * s * d, 6) for x in r]
+
+
+def write( nom, loi, n, d):
+	with open( nom, 'w') as f:
+		for _ in range( n):
+			f.write( ' '.join( str( v) for v in loi( d)) + '\n')
+	print( '%s (%d x %d)' % (nom, n, d))
+
+
+# runs Orion and returns its wall time, CPU time (s) and peak resident memory (MB)
+def run( orion, args):
+	debut = time.time()
+	p = subprocess.Popen( [orion] + args, stdout = subprocess.DEVNULL)
+	_, status, usage = os.wait4( p.pid, 0)
+	mur = time.time() - debut
+	if status != 0:
+		sys.exit( 'failed: ' + ' '.join( [orion] + args))
+	return mur, usage.ru_utime + usage.ru_stime, usage.ru_maxrss / 1024.
+
+
+def report( titre, mesure):
+	print( '  %-34s wall %7.2fs  cpu %7.2fs  peak %7.1f MB' % ((titre,) + mesure))
+	sys.stdout.flush()
+
+
+def rowmajor( orion):
+	for nom, loi, n in ( ('i10.txt', independent, 20000),
+						 ('a10.txt', anticorrelated, 4000),
+						 ('c10.txt', correlated, 200000)):
+		write( nom, loi, n, 10)
+		for algo in ('depth', 'breadth'):
+			for options in ([], ['-rowmajor']):
+				report( ' '.join( [algo] + options), run( orion, ['-a', algo] + options + [nom]))
+
+
+# 1, 2, 4... up to Max
+def threads( Max):
+	j = 1
+	while j < Max:
+		yield j
+		j *= 2
+	yield Max
+
+
+def lastnode( orion, Max):
+	write( 'u8.txt', uniform, 200000, 8)
+	for j in threads( Max):
+		report( 'depth -j %d' % j, run( orion, ['-a', 'depth', '-j', str( j), 'u8.txt']))
+
+
+def breadth( orion, Max):
+	for nom, loi, n, d in ( ('c20.txt', correlated, 400, 20), ('i12.txt', independent, 3000, 12)):
+		write( nom, loi, n, d)
+		for algo in ('breadth', 'br_dom'):
+			for j in threads( Max):
+				report( '%s -j %d' % (algo, j), run( orion, ['-a', algo, '-j', str( j), nom]))
+
+
+CASES = { 'rowmajor': rowmajor, 'lastnode': lastnode, 'breadth': breadth }
+
+if __name__ == '__main__':
+	if len( sys.argv) not in (3, 4) or sys.argv[2] not in CASES:
+		sys.exit( 'usage: benchmark.py ORION ' + '|'.join( sorted( CASES)) + ' [THREADS]')
+	orion = os.path.abspath( sys.argv[1])
+	Max = int( sys.argv[3]) if len( sys.argv) == 4 else os.cpu_count()
+	print( 'cores available: %d' % os.cpu_count())
+	random.seed( 42)
+	dossier = tempfile.mkdtemp()
+	os.chdir( dossier)
+	try:
+		if sys.argv[2] == 'rowmajor':
+			rowmajor( orion)
+		else:
+			CASES[sys.argv[2]]( orion, Max)
+	finally:
+		os.chdir( '/')
+		shutil.rmtree( dossier)
@@ -0,0 +1,14 @@
+# runs ORION with ARGS on a copy of SOURCE/DATA in WORK and compares WORK/RESULT with SOURCE/EXPECTED
+
+execute_process( COMMAND ${CMAKE_COMMAND} -E copy ${SOURCE}/${DATA} ${WORK}/${DATA})
+file( REMOVE ${WORK}/${RESULT})
+
+execute_process( COMMAND ${ORION} ${ARGS} ${WORK}/${DATA} RESULT_VARIABLE Code OUTPUT_VARIABLE Sortie)
+if( NOT Code EQUAL 0)
+	message( FATAL_ERROR "Orion failed (${Code}):\n${Sortie}")
+endif()
+
+execute_process( COMMAND ${CMAKE_COMMAND} -E compare_files ${WORK}/${RESULT} ${SOURCE}/${EXPECTED} RESULT_VARIABLE Difference)
+if( NOT Difference EQUAL 0)
+	message( FATAL_ERROR "${WORK}/${RESULT} differs from ${SOURCE}/${EXPECTED}")
+endif()